@@ -15,25 +15,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 // scale maps pixel coordinates to GL coordinates (-1 to 1).
 uniform vec2 scale;
-// The (x, y) coordinates of the top left corner of the glyph.
-uniform vec2 position;
-// The glyph to draw. (ASCII value - 32).
-uniform int glyph;
-// Aspect ratio of rendered glyph (unity by default).
-uniform float aspect;
-// Glyph size (in pixels).
-uniform vec2 glyphSize;
 
-// Inputs from the VBO.
+// Inputs from the VBO: the pixel coordinates of this corner of a glyph, and the
+// matching texture coordinates of that glyph in the font image.
 in vec2 vert;
 in vec2 corner;
 
 // Output to the fragment shader.
 out vec2 texCoord;
 
-// Pick the proper glyph out of the texture.
 void main() {
-	texCoord = vec2((float(glyph) + corner.x) / 98.f, corner.y);
-	vec2 pos = vert * glyphSize;
-	gl_Position = vec4((aspect * pos.x + position.x) * scale.x, (pos.y + position.y) * scale.y, 0.f, 1.f);
+	texCoord = corner;
+	gl_Position = vec4(vert * scale, 0.f, 1.f);
 }
@@ -25,6 +25,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "text/Format.h"
 #include "FormationPattern.h"
 #include "FormationPositioner.h"
+#include "FrameArena.h"
 #include "GameData.h"
 #include "Gamerules.h"
 #include "Government.h"
@@ -182,7 +183,7 @@ namespace {
 			return NPCDisposition::UNKNOWN;
 
 		// Get the encounter record for this NPC
-		const EncounterRecord *record = player.Encounters().Get(npc.UUID().ToString());
+		const EncounterRecord *record = player.Encounters().Get(npc.UUID());
 		if(!record)
 			return NPCDisposition::UNKNOWN;
 
@@ -226,7 +227,7 @@ namespace {
 	// Flee urgency from encounter history. Range: 0.0 (none) to 1.0+ (extreme).
 	double GetFleeUrgency(const Ship &npc, const PlayerInfo &player)
 	{
-		const EncounterRecord *record = player.Encounters().Get(npc.UUID().ToString());
+		const EncounterRecord *record = player.Encounters().Get(npc.UUID());
 		if(!record)
 			return 0.;
 
@@ -276,6 +277,9 @@ namespace {
 	constexpr double STRENGTH_RATIO_TO_BROADCAST = 1.5;
 	constexpr double STRENGTH_RATIO_TO_RESPOND = 0.8;
 
+	// Routes are kept across system jumps, so put a bound on how many there can be.
+	constexpr size_t MAX_CACHED_ROUTES = 4096;
+
 	bool ShouldBroadcastDistress(const Ship &ship, int64_t myStrength, int64_t attackerStrength)
 	{
 		if(ship.IsDisabled() || ship.IsDestroyed())
@@ -752,20 +756,25 @@ void AI::UpdateEvents(const list<ShipEvent> &events)
 		if(!target)
 			continue;
 
-		if(event.Actor())
+		// Ships that never entered flight (e.g. ones destroyed while still
+		// docked) have no handle, so nothing can be remembered about them.
+		const SlotHandle &targetHandle = target->Handle();
+		if(event.Actor() && !targetHandle.IsNull() && !event.Actor()->Handle().IsNull())
 		{
-			actions[event.Actor()][target] |= event.Type();
+			actions[event.Actor()->Handle()][targetHandle] |= event.Type();
 			if(event.TargetGovernment())
-				notoriety[event.Actor()][event.TargetGovernment()] |= event.Type();
+				notoriety[event.Actor()->Handle()][event.TargetGovernment()] |= event.Type();
 		}
 
 		const auto &actorGovernment = event.ActorGovernment();
 		if(actorGovernment)
 		{
-			governmentActions[actorGovernment][target] |= event.Type();
+			if(!targetHandle.IsNull())
+				governmentActions[actorGovernment][targetHandle] |= event.Type();
 			if(actorGovernment->IsPlayer() && event.TargetGovernment())
 			{
-				int &bitmap = playerActions[target];
+				int unrecorded = 0;
+				int &bitmap = targetHandle.IsNull() ? unrecorded : playerActions[targetHandle];
 				int newActions = event.Type() - (event.Type() & bitmap);
 				bitmap |= event.Type();
 				// If you provoke the same ship twice, it should have an effect both times.
@@ -823,7 +832,10 @@ void AI::Clean()
 	miningTime.clear();
 	appeasementThreshold.clear();
 	boarders.clear();
-	routeCache.clear();
+	// Routes planned by other ships remain valid until the map changes, but the
+	// player's escorts only use the routes the player knows about, and that
+	// knowledge grows as the player explores.
+	erase_if(routeCache, [](const auto &it) { return it.first.forPlayer; });
 	// Records for formations flying around lead ships and other objects.
 	formations.clear();
 	// Records that affect the combat behavior of various governments.
@@ -853,7 +865,7 @@ void AI::Step(Command &activeCommands)
 {
 	// First, figure out the comparative strengths of the present governments.
 	const System *playerSystem = player.GetSystem();
-	map<const Government *, int64_t> strength;
+	pmr::map<const Government *, int64_t> strength(FrameArena::Resource());
 	UpdateStrengths(strength, playerSystem);
 	CacheShipLists();
 
@@ -1552,25 +1564,27 @@ const StellarObject *AI::FindLandingLocation(const Ship &ship, const bool refuel
 
 AI::RouteCacheKey::RouteCacheKey(
 	const System *from, const System *to, const Government *gov, double jumpDistance,
-	JumpType jumpType, const vector<string> &wormholeKeys)
-		: from(from), to(to), gov(gov), jumpDistance(jumpDistance), jumpType(jumpType), wormholeKeys(wormholeKeys)
+	JumpType jumpType, vector<uint64_t> wormholeAccess, bool forPlayer)
+		: from(from), to(to), gov(gov), jumpDistance(jumpDistance), jumpType(jumpType),
+		wormholeAccess(std::move(wormholeAccess)), forPlayer(forPlayer)
 {
+	// Combine the hashes of each input the same way boost::hash_combine does.
+	auto combine = [this](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+	hash = std::hash<const System *>()(from);
+	combine(std::hash<const System *>()(to));
+	combine(std::hash<const Government *>()(gov));
+	combine(std::hash<double>()(jumpDistance));
+	combine(static_cast<size_t>(jumpType));
+	for(uint64_t bits : this->wormholeAccess)
+		combine(std::hash<uint64_t>()(bits));
+	combine(forPlayer);
 }
 
 
 
 size_t AI::RouteCacheKey::HashFunction::operator()(RouteCacheKey const &key) const
 {
-	// Used by unordered_map to determine equivalence.
-	int shift = 0;
-	size_t hash = std::hash<string>()(key.from->TrueName());
-	hash ^= std::hash<string>()(key.to->TrueName()) << ++shift;
-	hash ^= std::hash<string>()(key.gov->TrueName()) << ++shift;
-	hash ^= std::hash<int>()(key.jumpDistance) << ++shift;
-	hash ^= std::hash<int>()(static_cast<std::size_t>(key.jumpType)) << ++shift;
-	for(const string &k : key.wormholeKeys)
-		hash ^= std::hash<string>()(k) << ++shift;;
-	return hash;
+	return key.hash;
 }
 
 
@@ -1578,12 +1592,14 @@ size_t AI::RouteCacheKey::HashFunction::operator()(RouteCacheKey const &key) con
 bool AI::RouteCacheKey::operator==(const RouteCacheKey &other) const
 {
 	// Used by unordered_map to determine equivalence.
-	return from == other.from
+	return hash == other.hash
+		&& from == other.from
 		&& to == other.to
 		&& gov == other.gov
 		&& jumpDistance == other.jumpDistance
 		&& jumpType == other.jumpType
-		&& wormholeKeys == other.wormholeKeys;
+		&& forPlayer == other.forPlayer
+		&& wormholeAccess == other.wormholeAccess;
 }
 
 
@@ -1996,8 +2012,7 @@ AI::CombatMemoryHints AI::GetCombatMemoryHints(const Ship &npc) const
 {
 	CombatMemoryHints hints;
 
-	string uuid = npc.UUID().ToString();
-	const EncounterRecord *record = player.Encounters().Get(uuid);
+	const EncounterRecord *record = player.Encounters().Get(npc.UUID());
 	if(!record || record->combatEncounters < 2)
 		return hints;
 
@@ -2059,7 +2074,7 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 	// Ships with 'plunders' personality always destroy the ships they have boarded
 	// unless they also have either or both of the 'disables' or 'merciful' personalities.
 	if(oldTarget && person.Plunders() && !person.Disables() && !person.IsMerciful()
-			&& oldTarget->IsDisabled() && Has(ship, oldTarget, ShipEvent::BOARD))
+			&& oldTarget->IsDisabled() && Has(ship, *oldTarget, ShipEvent::BOARD))
 		return oldTarget;
 	shared_ptr<Ship> parentTarget;
 	if(ship.GetParent() && !ship.GetParent()->GetGovernment()->IsEnemy(gov))
@@ -2126,7 +2141,7 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 
 		// Ships which only disable never target already-disabled ships.
 		if((person.Disables() || (!person.IsNemesis() && foe != oldTarget.get()))
-				&& foe->IsDisabled() && (!canPlunder || Has(ship, foe->shared_from_this(), ShipEvent::BOARD)))
+				&& foe->IsDisabled() && (!canPlunder || Has(ship, *foe, ShipEvent::BOARD)))
 			continue;
 
 		// Ships that don't (or can't) plunder strongly prefer active targets.
@@ -2138,7 +2153,7 @@ shared_ptr<Ship> AI::FindTarget(const Ship &ship) const
 			if(any_of(boarders.begin(), boarders.end(), [&ship, &foe](auto &it)
 					{ return it.first != &ship && it.second == foe; }))
 				continue;
-			range += 2000. * (2 * foe->IsDisabled() - !Has(ship, foe->shared_from_this(), ShipEvent::BOARD));
+			range += 2000. * (2 * foe->IsDisabled() - !Has(ship, *foe, ShipEvent::BOARD));
 		}
 
 		// Prefer to go after armed targets, especially if you're not a pirate.
@@ -2287,10 +2302,9 @@ shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 			for(const auto &it : GetShipsList(ship, false))
 				if(it->GetGovernment() != gov)
 				{
-					auto ptr = it->shared_from_this();
 					// Scan friendly ships that are as-yet unscanned by this ship's government.
-					if((!cargoScan || Has(gov, ptr, ShipEvent::SCAN_CARGO))
-							&& (!outfitScan || Has(gov, ptr, ShipEvent::SCAN_OUTFITS)))
+					if((!cargoScan || Has(gov, *it, ShipEvent::SCAN_CARGO))
+							&& (!outfitScan || Has(gov, *it, ShipEvent::SCAN_OUTFITS)))
 						continue;
 
 					// Divide the distance by 10,000 to normalize to the scan range that
@@ -2299,7 +2313,7 @@ shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 					if(range < closest)
 					{
 						closest = range;
-						target = std::move(ptr);
+						target = it->shared_from_this();
 					}
 				}
 		}
@@ -2313,12 +2327,13 @@ shared_ptr<Ship> AI::FindNonHostileTarget(const Ship &ship) const
 // Return a list of all targetable ships in the same system as the player that
 // match the desired hostility (i.e. enemy or non-enemy). Does not consider the
 // ship's current target, as its inclusion may or may not be desired.
-vector<Ship *> AI::GetShipsList(const Ship &ship, bool targetEnemies, double maxRange) const
+pmr::vector<Ship *> AI::GetShipsList(const Ship &ship, bool targetEnemies, double maxRange) const
 {
 	if(maxRange < 0.)
 		maxRange = numeric_limits<double>::infinity();
 
-	auto targets = vector<Ship *>();
+	// The list only lives for as long as the caller needs it, so take it from the frame arena.
+	auto targets = pmr::vector<Ship *>(FrameArena::Resource());
 
 	// The cached lists are built each step based on the current ships in the player's system.
 	const auto &rosters = targetEnemies ? enemyLists : allyLists;
@@ -2538,7 +2553,7 @@ void AI::MoveIndependent(Ship &ship, Command &command)
 	else if(target && (gov->IsEnemy(target->GetGovernment()) || friendlyOverride))
 	{
 		bool shouldBoard = ship.Cargo().Free() && ship.GetPersonality().Plunders();
-		bool hasBoarded = Has(ship, target, ShipEvent::BOARD);
+		bool hasBoarded = Has(ship, *target, ShipEvent::BOARD);
 		if(shouldBoard && target->IsDisabled() && !hasBoarded)
 		{
 			if(ship.IsBoarding())
@@ -2580,8 +2595,8 @@ void AI::MoveIndependent(Ship &ship, Command &command)
 				ship.SetTargetShip(nullptr);
 			}
 			// Detarget if I cannot scan, or if I already scanned the ship.
-			else if((!cargoScan || Has(gov, target, ShipEvent::SCAN_CARGO))
-					&& (!outfitScan || Has(gov, target, ShipEvent::SCAN_OUTFITS)))
+			else if((!cargoScan || Has(gov, *target, ShipEvent::SCAN_CARGO))
+					&& (!outfitScan || Has(gov, *target, ShipEvent::SCAN_OUTFITS)))
 			{
 				target.reset();
 				ship.SetTargetShip(nullptr);
@@ -3742,8 +3757,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 		bool outfitScan = ship.Attributes().Get("outfit scan power");
 		// If the pointer to the target ship exists, it is targetable and in-system.
 		const Government *gov = ship.GetGovernment();
-		bool mustScanCargo = cargoScan && !Has(gov, target, ShipEvent::SCAN_CARGO);
-		bool mustScanOutfits = outfitScan && !Has(gov, target, ShipEvent::SCAN_OUTFITS);
+		bool mustScanCargo = cargoScan && !Has(gov, *target, ShipEvent::SCAN_CARGO);
+		bool mustScanOutfits = outfitScan && !Has(gov, *target, ShipEvent::SCAN_OUTFITS);
 		if(!mustScanCargo && !mustScanOutfits)
 			ship.SetTargetShip(shared_ptr<Ship>());
 		else
@@ -3780,9 +3795,8 @@ void AI::DoSurveillance(Ship &ship, Command &command, shared_ptr<Ship> &target)
 			for(const auto &it : GetShipsList(ship, false))
 				if(it->GetGovernment() != gov)
 				{
-					auto ptr = it->shared_from_this();
-					if((!cargoScan || Has(gov, ptr, ShipEvent::SCAN_CARGO))
-							&& (!outfitScan || Has(gov, ptr, ShipEvent::SCAN_OUTFITS)))
+					if((!cargoScan || Has(gov, *it, ShipEvent::SCAN_CARGO))
+							&& (!outfitScan || Has(gov, *it, ShipEvent::SCAN_OUTFITS)))
 						continue;
 
 					if(it->IsTargetable())
@@ -4619,7 +4633,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 		if(weapon->Homing() && currentTarget)
 		{
 			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, currentTarget, ShipEvent::BOARD);
+			bool hasBoarded = !ship.IsYours() && Has(ship, *currentTarget, ShipEvent::BOARD);
 			if(currentTarget->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
 				continue;
 			// Don't fire secondary weapons at targets that have started jumping.
@@ -4654,7 +4668,7 @@ void AI::AutoFire(const Ship &ship, FireCommand &command, bool secondary, bool i
 		for(const auto &target : enemies)
 		{
 			// NPCs shoot ships that they just plundered.
-			bool hasBoarded = !ship.IsYours() && Has(ship, target->shared_from_this(), ShipEvent::BOARD);
+			bool hasBoarded = !ship.IsYours() && Has(ship, *target, ShipEvent::BOARD);
 			if(target->IsDisabled() && (disables || (plunders && !hasBoarded)) && !disabledOverride)
 				continue;
 			// Merciful ships let fleeing ships go.
@@ -5027,13 +5041,13 @@ void AI::MovePlayer(Ship &ship, Command &activeCommands)
 						return [this, &ship](const Ship &other) noexcept -> double
 						{
 							// Use the exact cost if the ship was scanned, otherwise use an estimation.
-							return this->Has(ship, other.shared_from_this(), ShipEvent::SCAN_OUTFITS) ?
+							return this->Has(ship, other, ShipEvent::SCAN_OUTFITS) ?
 								other.Cost() : (other.ChassisCost() * 2.);
 						};
 					case Preferences::BoardingPriority::MIXED:
 						return [this, &ship, current](const Ship &other) noexcept -> double
 						{
-							double cost = this->Has(ship, other.shared_from_this(), ShipEvent::SCAN_OUTFITS) ?
+							double cost = this->Has(ship, other, ShipEvent::SCAN_OUTFITS) ?
 								other.Cost() : (other.ChassisCost() * 2.);
 							// Even if we divide by 0, doubles can contain and handle infinity,
 							// and we should definitely board that one then.
@@ -5508,13 +5522,13 @@ void AI::DisengageAutopilot()
 
 
 
-bool AI::Has(const Ship &ship, const weak_ptr<const Ship> &other, int type) const
+bool AI::Has(const Ship &ship, const Ship &other, int type) const
 {
-	auto sit = actions.find(ship.shared_from_this());
+	auto sit = actions.find(ship.Handle());
 	if(sit == actions.end())
 		return false;
 
-	auto oit = sit->second.find(other);
+	auto oit = sit->second.find(other.Handle());
 	if(oit == sit->second.end())
 		return false;
 
@@ -5523,13 +5537,13 @@ bool AI::Has(const Ship &ship, const weak_ptr<const Ship> &other, int type) cons
 
 
 
-bool AI::Has(const Government *government, const weak_ptr<const Ship> &other, int type) const
+bool AI::Has(const Government *government, const Ship &other, int type) const
 {
 	auto git = governmentActions.find(government);
 	if(git == governmentActions.end())
 		return false;
 
-	auto oit = git->second.find(other);
+	auto oit = git->second.find(other.Handle());
 	if(oit == git->second.end())
 		return false;
 
@@ -5542,7 +5556,7 @@ bool AI::Has(const Government *government, const weak_ptr<const Ship> &other, in
 // example, if the player boarded any ship belonging to that government.
 bool AI::Has(const Ship &ship, const Government *government, int type) const
 {
-	auto sit = notoriety.find(ship.shared_from_this());
+	auto sit = notoriety.find(ship.Handle());
 	if(sit == notoriety.end())
 		return false;
 
@@ -5555,7 +5569,7 @@ bool AI::Has(const Ship &ship, const Government *government, int type) const
 
 
 
-void AI::UpdateStrengths(map<const Government *, int64_t> &strength, const System *playerSystem)
+void AI::UpdateStrengths(pmr::map<const Government *, int64_t> &strength, const System *playerSystem)
 {
 	// Tally the strength of a government by the strength of its present and able ships.
 	governmentRosters.clear();
@@ -5572,7 +5586,7 @@ void AI::UpdateStrengths(map<const Government *, int64_t> &strength, const Syste
 	allyStrength.clear();
 	for(const auto &gov : strength)
 	{
-		set<const Government *> allies;
+		pmr::set<const Government *> allies(FrameArena::Resource());
 		for(const auto &enemy : strength)
 			if(enemy.first->IsEnemy(gov.first))
 			{
@@ -5619,18 +5633,20 @@ void AI::UpdateStrengths(map<const Government *, int64_t> &strength, const Syste
 // Cache various lists of all targetable ships in the player's system for this Step.
 void AI::CacheShipLists()
 {
-	allyLists.clear();
-	enemyLists.clear();
+	// Empty the lists in place rather than discarding them, so that once each
+	// government's lists have grown large enough they are reused every step.
+	// Governments that are not present just end up with empty lists.
+	for(auto &it : allyLists)
+		it.second.clear();
+	for(auto &it : enemyLists)
+		it.second.clear();
 	for(const auto &git : governmentRosters)
 	{
-		allyLists.emplace(git.first, vector<Ship *>());
-		allyLists.at(git.first).reserve(ships.size());
-		enemyLists.emplace(git.first, vector<Ship *>());
-		enemyLists.at(git.first).reserve(ships.size());
+		vector<Ship *> &allies = allyLists[git.first];
+		vector<Ship *> &enemies = enemyLists[git.first];
 		for(const auto &oit : governmentRosters)
 		{
-			auto &list = git.first->IsEnemy(oit.first)
-					? enemyLists[git.first] : allyLists[git.first];
+			auto &list = git.first->IsEnemy(oit.first) ? enemies : allies;
 			list.insert(list.end(), oit.second.begin(), oit.second.end());
 		}
 	}
@@ -5822,8 +5838,12 @@ void AI::UpdateOrders(const Ship &ship)
 RoutePlan AI::GetRoutePlan(const Ship &ship, const System *targetSystem)
 {
 	// Note: RecacheJumpRoutes will check and reset the value for us.
-	if(player.RecacheJumpRoutes())
+	if(player.RecacheJumpRoutes() || routeCacheVersion != GameData::UniverseVersion()
+			|| routeCache.size() >= MAX_CACHED_ROUTES)
+	{
 		routeCache.clear();
+		routeCacheVersion = GameData::UniverseVersion();
+	}
 
 	const System *from = ship.GetSystem();
 	const Government *gov = ship.GetGovernment();
@@ -5831,21 +5851,27 @@ RoutePlan AI::GetRoutePlan(const Ship &ship, const System *targetSystem)
 
 	// A cached route that could be used for this ship could depend on the wormholes which this ship can
 	// travel through. Find the intersection of all known wormhole required attributes and the attributes
-	// which this ship satisfies.
-	vector<string> wormholeKeys;
+	// which this ship satisfies, as a mask over the (ordered) set of those attributes.
+	const set<string> &requirements = GameData::UniverseWormholeRequirements();
+	vector<uint64_t> wormholeAccess((requirements.size() + 63) / 64);
 	const auto &shipAttributes = ship.Attributes();
-	for(const auto &requirement : GameData::UniverseWormholeRequirements())
+	size_t index = 0;
+	for(const auto &requirement : requirements)
+	{
 		if(shipAttributes.Get(requirement) > 0)
-			wormholeKeys.emplace_back(requirement);
+			wormholeAccess[index / 64] |= uint64_t(1) << (index % 64);
+		++index;
+	}
 
+	const bool forPlayer = ship.IsYours();
 	auto key = RouteCacheKey(from, targetSystem, gov, ship.JumpNavigation().JumpRange(), driveCapability,
-		wormholeKeys);
+		std::move(wormholeAccess), forPlayer);
 
 	RoutePlan route;
 	auto it = routeCache.find(key);
 	if(it == routeCache.end())
 	{
-		route = RoutePlan(ship, *targetSystem, ship.IsYours() ? &player : nullptr);
+		route = RoutePlan(ship, *targetSystem, forPlayer ? &player : nullptr);
 		routeCache.emplace(key, route);
 	}
 	else
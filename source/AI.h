@@ -23,11 +23,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "orders/OrderSet.h"
 #include "Point.h"
 #include "RoutePlan.h"
+#include "SlotMap.h"
 
 #include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <set>
 #include <unordered_map>
@@ -106,8 +108,11 @@ private:
 		// - from, to, jumpRange, driveType
 		// - gov: danger = f(gov), isRestrictedFrom = f(gov)
 		// - wormhole requirements that are met, see Planet::IsAccessible(const Ship *ship)
+		// - whether the route is limited to what the player knows about
+		// The wormhole requirements are given as a mask of which entries of
+		// GameData::UniverseWormholeRequirements() the ship satisfies.
 		explicit RouteCacheKey(const System *from, const System *to, const Government *gov,
-			double jumpDistance, JumpType jumpType, const std::vector<std::string> &wormholeKeys);
+			double jumpDistance, JumpType jumpType, std::vector<uint64_t> wormholeAccess, bool forPlayer);
 
 		// To support use as a map key:
 		bool operator==(const RouteCacheKey &other) const;
@@ -125,7 +130,10 @@ private:
 		const Government *gov;
 		double jumpDistance;
 		JumpType jumpType;
-		std::vector<std::string> wormholeKeys;
+		std::vector<uint64_t> wormholeAccess;
+		bool forPlayer;
+		// The hash is computed once, since the same key is often looked up many times.
+		size_t hash;
 	};
 
 
@@ -162,7 +170,7 @@ private:
 	std::shared_ptr<Ship> FindTarget(const Ship &ship) const;
 	std::shared_ptr<Ship> FindNonHostileTarget(const Ship &ship) const;
 	// Obtain a list of ships matching the desired hostility.
-	std::vector<Ship *> GetShipsList(const Ship &ship, bool targetEnemies, double maxRange = -1.) const;
+	std::pmr::vector<Ship *> GetShipsList(const Ship &ship, bool targetEnemies, double maxRange = -1.) const;
 
 	bool FollowOrders(Ship &ship, Command &command);
 	void MoveInFormation(Ship &ship, Command &command);
@@ -232,14 +240,14 @@ private:
 	// True if found asteroid.
 	bool TargetMinable(Ship &ship) const;
 	// True if the ship performed the indicated event to the other ship.
-	bool Has(const Ship &ship, const std::weak_ptr<const Ship> &other, int type) const;
+	bool Has(const Ship &ship, const Ship &other, int type) const;
 	// True if the government performed the indicated event to the other ship.
-	bool Has(const Government *government, const std::weak_ptr<const Ship> &other, int type) const;
+	bool Has(const Government *government, const Ship &other, int type) const;
 	// True if the ship has performed the indicated event against any member of the government.
 	bool Has(const Ship &ship, const Government *government, int type) const;
 
 	// Functions to classify ships based on government and system.
-	void UpdateStrengths(std::map<const Government *, int64_t> &strength, const System *playerSystem);
+	void UpdateStrengths(std::pmr::map<const Government *, int64_t> &strength, const System *playerSystem);
 	void CacheShipLists();
 
 	/// Register autoconditions that use the current AI state (ships in the system, strengths, etc.)
@@ -287,13 +295,16 @@ private:
 	// ordinary pointers instead of weak pointers.
 	std::map<const Ship *, OrderSet> orders;
 
-	// Records of what various AI ships and factions have done.
-	typedef std::owner_less<std::weak_ptr<const Ship>> Comp;
-	std::map<std::weak_ptr<const Ship>, std::map<std::weak_ptr<const Ship>, int, Comp>, Comp> actions;
-	std::map<std::weak_ptr<const Ship>, std::map<const Government *, int>, Comp> notoriety;
-	std::map<const Government *, std::map<std::weak_ptr<const Ship>, int, Comp>> governmentActions;
+	// Records of what various AI ships and factions have done. Ships are keyed
+	// by the handle the engine gave them, which stays unique even after the ship
+	// is gone, so these lookups need no reference counting.
+	template<class Value>
+	using HandleMap = std::unordered_map<SlotHandle, Value, SlotHandle::Hash>;
+	HandleMap<HandleMap<int>> actions;
+	HandleMap<std::map<const Government *, int>> notoriety;
+	std::map<const Government *, HandleMap<int>> governmentActions;
 	std::map<const Government *, bool> scanPermissions;
-	std::map<std::weak_ptr<const Ship>, int, Comp> playerActions;
+	HandleMap<int> playerActions;
 	std::map<const Ship *, std::weak_ptr<Ship>> helperList;
 	std::map<const Ship *, int> swarmCount;
 	std::map<const Ship *, int> fenceCount;
@@ -319,6 +330,8 @@ private:
 
 	// Route planning cache:
 	std::unordered_map<RouteCacheKey, RoutePlan, RouteCacheKey::HashFunction> routeCache;
+	// The universe version the cached routes were planned for.
+	uint64_t routeCacheVersion = 0;
 
 	// Cached player behavior pattern, updated periodically for performance.
 	mutable BehaviorPattern cachedPlayerPattern = BehaviorPattern::UNKNOWN;
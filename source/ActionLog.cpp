@@ -27,6 +27,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	const int HOSTILE_EVENTS = ShipEvent::DESTROY | ShipEvent::DISABLE | ShipEvent::CAPTURE;
+}
+
 
 
 // ActionRecord constructor with all fields.
@@ -46,10 +50,21 @@ ActionLog::ActionLog(size_t maxRecords)
 
 
 
+// The days are visited from the oldest to the most recent. Each day is
+// given along with how many days before the reference date it is.
+template<class Function>
+void ActionLog::ForEachDay(const Date &referenceDate, int days, Function function) const
+{
+	const int reference = referenceDate.DaysSinceEpoch();
+	for(auto it = dayTotals.lower_bound(reference - days); it != dayTotals.end() && it->first <= reference; ++it)
+		function(reference - it->first, it->second);
+}
+
+
+
 void ActionLog::Load(const DataNode &node)
 {
-	records.clear();
-	cacheValid = false;
+	Clear();
 
 	for(const DataNode &child : node)
 	{
@@ -78,7 +93,7 @@ void ActionLog::Load(const DataNode &node)
 					record.wasWitnessed = (grand.Value(1) != 0);
 			}
 
-			records.push_back(record);
+			Append(record);
 		}
 	}
 
@@ -122,16 +137,16 @@ void ActionLog::Save(DataWriter &out) const
 void ActionLog::Clear()
 {
 	records.clear();
-	hostileActionCache.clear();
-	cacheValid = false;
+	dayTotals.clear();
+	governmentRecords.clear();
+	firstSequence = 0;
 }
 
 
 
 void ActionLog::Record(const ActionRecord &record)
 {
-	records.push_back(record);
-	cacheValid = false;
+	Append(record);
 	TrimToMaxSize();
 }
 
@@ -190,9 +205,16 @@ vector<const ActionRecord *> ActionLog::GetActionsAgainst(const Government *gov,
 	const Date &referenceDate, int days) const
 {
 	vector<const ActionRecord *> result;
-	for(const ActionRecord &record : records)
-		if(record.targetGov == gov && IsWithinRange(record, referenceDate, days))
+	auto it = governmentRecords.find(gov);
+	if(it == governmentRecords.end())
+		return result;
+
+	for(uint64_t sequence : it->second)
+	{
+		const ActionRecord &record = records[sequence - firstSequence];
+		if(IsWithinRange(record, referenceDate, days))
 			result.push_back(&record);
+	}
 	return result;
 }
 
@@ -201,9 +223,11 @@ vector<const ActionRecord *> ActionLog::GetActionsAgainst(const Government *gov,
 int ActionLog::CountEventType(int eventType, const Date &referenceDate, int days) const
 {
 	int count = 0;
-	for(const ActionRecord &record : records)
-		if((record.eventType & eventType) && IsWithinRange(record, referenceDate, days))
-			++count;
+	ForEachDay(referenceDate, days, [&](int, const DayTotals &totals) {
+		for(const auto &it : totals.eventTypes)
+			if(it.first & eventType)
+				count += it.second;
+	});
 	return count;
 }
 
@@ -212,9 +236,11 @@ int ActionLog::CountEventType(int eventType, const Date &referenceDate, int days
 int ActionLog::GetCrewKilledAgainst(const Government *gov, const Date &referenceDate, int days) const
 {
 	int total = 0;
-	for(const ActionRecord &record : records)
-		if(record.targetGov == gov && IsWithinRange(record, referenceDate, days))
-			total += record.crewKilled;
+	ForEachDay(referenceDate, days, [&](int, const DayTotals &totals) {
+		auto it = totals.governments.find(gov);
+		if(it != totals.governments.end())
+			total += it->second.crewKilled;
+	});
 	return total;
 }
 
@@ -223,9 +249,11 @@ int ActionLog::GetCrewKilledAgainst(const Government *gov, const Date &reference
 int64_t ActionLog::GetValueDestroyedAgainst(const Government *gov, const Date &referenceDate, int days) const
 {
 	int64_t total = 0;
-	for(const ActionRecord &record : records)
-		if(record.targetGov == gov && IsWithinRange(record, referenceDate, days))
-			total += record.valueDestroyed;
+	ForEachDay(referenceDate, days, [&](int, const DayTotals &totals) {
+		auto it = totals.governments.find(gov);
+		if(it != totals.governments.end())
+			total += it->second.valueDestroyed;
+	});
 	return total;
 }
 
@@ -240,36 +268,38 @@ BehaviorPattern ActionLog::GetPatternScore(const Date &referenceDate, int days)
 	int hostileActions = 0;    // All attacks
 
 	set<const Government *> govTargets;
+	map<const Government *, int> hostileTargets;
 
-	for(const ActionRecord &record : records)
-	{
-		if(!IsWithinRange(record, referenceDate, days))
-			continue;
-
-		// Track distinct government targets.
-		if(record.targetGov)
-			govTargets.insert(record.targetGov);
-
-		// Categorize the action.
-		if(record.eventType & ShipEvent::ASSIST)
-			++protectorActions;
-
-		if(record.eventType & (ShipEvent::DESTROY | ShipEvent::DISABLE | ShipEvent::CAPTURE))
+	ForEachDay(referenceDate, days, [&](int, const DayTotals &totals) {
+		// Categorize the actions.
+		for(const auto &it : totals.eventTypes)
 		{
-			++hostileActions;
+			if(it.first & ShipEvent::ASSIST)
+				protectorActions += it.second;
+			if(it.first & HOSTILE_EVENTS)
+				hostileActions += it.second;
+		}
 
-			// Determine if target was "pirate-like" or "civilian-like".
-			if(record.targetGov)
+		// Track distinct government targets.
+		for(const auto &it : totals.governments)
+			if(it.first)
 			{
-				// If we attacked a pirate government, that's bounty hunting.
-				// If we attacked a legitimate government, that's piracy.
-				// This is a simplification; could be enhanced with government attributes.
-				if(record.targetGov->IsEnemy())
-					++bountyActions;
-				else
-					++pirateActions;
+				govTargets.insert(it.first);
+				if(it.second.hostile)
+					hostileTargets[it.first] += it.second.hostile;
 			}
-		}
+	});
+
+	// Determine if each target was "pirate-like" or "civilian-like".
+	// If we attacked a pirate government, that's bounty hunting.
+	// If we attacked a legitimate government, that's piracy.
+	// This is a simplification; could be enhanced with government attributes.
+	for(const auto &it : hostileTargets)
+	{
+		if(it.first->IsEnemy())
+			bountyActions += it.second;
+		else
+			pirateActions += it.second;
 	}
 
 	// Determine dominant pattern based on action ratios.
@@ -310,9 +340,16 @@ double ActionLog::GetHostilityScore(const Government *gov, const Date &reference
 	const double CREW_KILL_WEIGHT = 0.02;
 	const double VALUE_WEIGHT = 0.00001;
 
-	for(const ActionRecord &record : records)
+	auto it = governmentRecords.find(gov);
+	if(it == governmentRecords.end())
+		return score;
+
+	// The witness multiplier applies to the score so far, so the records must
+	// be visited in the order they were recorded.
+	for(uint64_t sequence : it->second)
 	{
-		if(record.targetGov != gov || !IsWithinRange(record, referenceDate, days))
+		const ActionRecord &record = records[sequence - firstSequence];
+		if(!IsWithinRange(record, referenceDate, days))
 			continue;
 
 		// Base score for any hostile action.
@@ -356,22 +393,18 @@ bool ActionLog::HasEscalationPattern(const Government *gov, const Date &referenc
 	int middleCount = 0;
 	int recentCount = 0;
 
-	for(const ActionRecord &record : records)
-	{
-		if(record.targetGov != gov)
-			continue;
-
-		int daysAgo = referenceDate - record.date;
-		if(daysAgo < 0 || daysAgo > days)
-			continue;
+	ForEachDay(referenceDate, days, [&](int daysAgo, const DayTotals &totals) {
+		auto it = totals.governments.find(gov);
+		if(it == totals.governments.end())
+			return;
 
 		if(daysAgo <= thirdDays)
-			++recentCount;
+			recentCount += it->second.records;
 		else if(daysAgo <= thirdDays * 2)
-			++middleCount;
+			middleCount += it->second.records;
 		else
-			++earlyCount;
-	}
+			earlyCount += it->second.records;
+	});
 
 	// Escalation pattern: each period has more actions than the previous.
 	return (recentCount > middleCount) && (middleCount > earlyCount) && (earlyCount > 0);
@@ -382,11 +415,11 @@ bool ActionLog::HasEscalationPattern(const Government *gov, const Date &referenc
 int ActionLog::GetDistinctTargets(const Date &referenceDate, int days) const
 {
 	set<const Government *> targets;
-	for(const ActionRecord &record : records)
-	{
-		if(record.targetGov && IsWithinRange(record, referenceDate, days))
-			targets.insert(record.targetGov);
-	}
+	ForEachDay(referenceDate, days, [&](int, const DayTotals &totals) {
+		for(const auto &it : totals.governments)
+			if(it.first)
+				targets.insert(it.first);
+	});
 	return static_cast<int>(targets.size());
 }
 
@@ -397,15 +430,10 @@ double ActionLog::GetWitnessedRatio(const Date &referenceDate, int days) const
 	int witnessed = 0;
 	int total = 0;
 
-	for(const ActionRecord &record : records)
-	{
-		if(IsWithinRange(record, referenceDate, days))
-		{
-			++total;
-			if(record.wasWitnessed)
-				++witnessed;
-		}
-	}
+	ForEachDay(referenceDate, days, [&](int, const DayTotals &totals) {
+		total += totals.records;
+		witnessed += totals.witnessed;
+	});
 
 	return total > 0 ? static_cast<double>(witnessed) / total : 0.0;
 }
@@ -420,12 +448,76 @@ bool ActionLog::IsWithinRange(const ActionRecord &record, const Date &referenceD
 
 
 
+void ActionLog::Append(const ActionRecord &record)
+{
+	governmentRecords[record.targetGov].push_back(firstSequence + records.size());
+	records.push_back(record);
+	AddToTotals(record);
+}
+
+
+
+void ActionLog::AddToTotals(const ActionRecord &record)
+{
+	DayTotals &totals = dayTotals[record.date.DaysSinceEpoch()];
+	++totals.records;
+	if(record.wasWitnessed)
+		++totals.witnessed;
+	++totals.eventTypes[record.eventType];
+
+	GovernmentTotals &government = totals.governments[record.targetGov];
+	++government.records;
+	if(record.eventType & HOSTILE_EVENTS)
+		++government.hostile;
+	government.crewKilled += record.crewKilled;
+	government.valueDestroyed += record.valueDestroyed;
+}
+
+
+
+void ActionLog::RemoveFromTotals(const ActionRecord &record)
+{
+	auto dit = dayTotals.find(record.date.DaysSinceEpoch());
+	DayTotals &totals = dit->second;
+	if(!--totals.records)
+	{
+		dayTotals.erase(dit);
+		return;
+	}
+	if(record.wasWitnessed)
+		--totals.witnessed;
+	auto eit = totals.eventTypes.find(record.eventType);
+	if(!--eit->second)
+		totals.eventTypes.erase(eit);
+
+	auto git = totals.governments.find(record.targetGov);
+	GovernmentTotals &government = git->second;
+	if(!--government.records)
+	{
+		totals.governments.erase(git);
+		return;
+	}
+	if(record.eventType & HOSTILE_EVENTS)
+		--government.hostile;
+	government.crewKilled -= record.crewKilled;
+	government.valueDestroyed -= record.valueDestroyed;
+}
+
+
+
 void ActionLog::TrimToMaxSize()
 {
 	while(records.size() > maxRecords)
 	{
+		const ActionRecord &oldest = records.front();
+		RemoveFromTotals(oldest);
+		auto it = governmentRecords.find(oldest.targetGov);
+		it->second.pop_front();
+		if(it->second.empty())
+			governmentRecords.erase(it);
+
 		records.pop_front();
-		cacheValid = false;
+		++firstSequence;
 	}
 }
 
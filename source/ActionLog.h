@@ -160,11 +160,43 @@ public:
 	double GetWitnessedRatio(const Date &referenceDate, int days = 30) const;
 
 
+private:
+	// Running totals of the records against one government on one day.
+	class GovernmentTotals {
+	public:
+		int records = 0;
+		// Records of a DESTROY, DISABLE or CAPTURE.
+		int hostile = 0;
+		int crewKilled = 0;
+		int64_t valueDestroyed = 0;
+	};
+
+	// Running totals of all the records from one day. These are integer
+	// counts and sums, so adding and removing records keeps them exact.
+	class DayTotals {
+	public:
+		int records = 0;
+		int witnessed = 0;
+		// Number of records with each event type bitmask.
+		std::map<int, int> eventTypes;
+		std::map<const Government *, GovernmentTotals> governments;
+	};
+
+
 private:
 	// Helper to check if a record falls within a date range.
 	bool IsWithinRange(const ActionRecord &record, const Date &referenceDate,
 		int days) const;
 
+	// Add a record to the newest end of the log, without trimming it.
+	void Append(const ActionRecord &record);
+	// Add or remove the given record from the running totals.
+	void AddToTotals(const ActionRecord &record);
+	void RemoveFromTotals(const ActionRecord &record);
+	// Call the given function for the totals of each day within a date range.
+	template<class Function>
+	void ForEachDay(const Date &referenceDate, int days, Function function) const;
+
 	// Trim the log to the maximum size, removing oldest entries first.
 	void TrimToMaxSize();
 
@@ -180,9 +212,13 @@ private:
 	// Maximum number of records to retain.
 	size_t maxRecords = DEFAULT_MAX_RECORDS;
 
-	// Cached per-government statistics for faster queries.
-	// Maps government pointer to count of hostile actions.
-	// This cache is rebuilt on load and updated on record.
-	mutable std::map<const Government *, int> hostileActionCache;
-	mutable bool cacheValid = false;
+	// The totals of each day that has any records, keyed by the number of
+	// days since the epoch. Queries over a date range only need to visit
+	// the days in that range, no matter how many records there are.
+	std::map<int, DayTotals> dayTotals;
+	// For queries that depend on the order of the records, the sequence
+	// numbers of the records against each government, oldest first. The
+	// oldest record in the log has the sequence number firstSequence.
+	std::map<const Government *, std::deque<uint64_t>> governmentRecords;
+	uint64_t firstSequence = 0;
 };
@@ -88,16 +88,19 @@ void BookEntry::Save(DataWriter &out) const
 
 
 
-int BookEntry::Draw(const Point &topLeft, WrappedText &wrap, const Color &color) const
+int BookEntry::Draw(const Point &topLeft, const WrappedText &wrap, const Color &color) const
 {
+	layouts.resize(items.size());
+
 	Point drawPoint = topLeft;
-	for(const Item &item : items)
+	for(size_t i = 0; i < items.size(); ++i)
 	{
+		const Item &item = items[i];
 		if(holds_alternative<string>(item))
 		{
-			wrap.Wrap(std::get<string>(item));
-			wrap.Draw(drawPoint, color);
-			drawPoint.Y() += wrap.Height();
+			const WrappedText &layout = layouts[i].Get(std::get<string>(item), wrap);
+			layout.Draw(drawPoint, color);
+			drawPoint.Y() += layout.Height();
 		}
 		else
 		{
@@ -15,6 +15,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "text/WrappedTextCache.h"
+
 #include <map>
 #include <string>
 #include <variant>
@@ -25,7 +27,6 @@ class DataNode;
 class DataWriter;
 class Point;
 class Sprite;
-class WrappedText;
 
 
 
@@ -45,8 +46,9 @@ public:
 
 	void Save(DataWriter &out) const;
 
-	// Returns height.
-	int Draw(const Point &topLeft, WrappedText &wrap, const Color &color) const;
+	// Returns height. The given object only supplies the text formatting; the
+	// layout of each paragraph is cached until that formatting changes.
+	int Draw(const Point &topLeft, const WrappedText &wrap, const Color &color) const;
 
 
 private:
@@ -55,4 +57,7 @@ private:
 
 private:
 	std::vector<Item> items;
+	// The wrapped layout of each text item, indexed like the items. Items are
+	// only ever appended, so this never goes out of step with them.
+	mutable std::vector<WrappedTextCache> layouts;
 };
@@ -20,6 +20,33 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 using namespace std;
 
+namespace {
+	// Read an unsigned integer written by DataWriter's binary encoding. Returns
+	// false if the data ends before the integer does.
+	bool ReadVarint(const string &data, size_t &pos, size_t &value)
+	{
+		value = 0;
+		for(int shift = 0; pos < data.size() && shift < 64; shift += 7)
+		{
+			unsigned char byte = static_cast<unsigned char>(data[pos++]);
+			value |= static_cast<size_t>(byte & 0x7F) << shift;
+			if(!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+}
+
+const string DataFile::BINARY_SIGNATURE = "\x7FGSDATA";
+
+
+
+// Check whether the given data is in the binary encoding.
+bool DataFile::IsBinary(const string &data)
+{
+	return !data.compare(0, BINARY_SIGNATURE.size(), BINARY_SIGNATURE);
+}
+
 
 
 // Constructor, taking a file path (in UTF-8).
@@ -45,14 +72,20 @@ void DataFile::Load(const filesystem::path &path)
 	if(data.empty())
 		return;
 
-	// As a sentinel, make sure the file always ends in a newline.
-	if(data.back() != '\n')
-		data.push_back('\n');
-
 	// Note what file this node is in, so it will show up in error traces.
 	root.tokens.push_back("file");
 	root.tokens.push_back(path.string());
 
+	if(IsBinary(data))
+	{
+		LoadBinary(data);
+		return;
+	}
+
+	// As a sentinel, make sure the file always ends in a newline.
+	if(data.back() != '\n')
+		data.push_back('\n');
+
 	LoadData(data);
 }
 
@@ -71,6 +104,11 @@ void DataFile::Load(istream &in)
 		in.read(&*data.begin() + currentSize, BLOCK);
 		data.resize(currentSize + in.gcount());
 	}
+	if(IsBinary(data))
+	{
+		LoadBinary(data);
+		return;
+	}
 	// As a sentinel, make sure the file always ends in a newline.
 	if(data.empty() || data.back() != '\n')
 		data.push_back('\n');
@@ -238,3 +276,65 @@ void DataFile::LoadData(const string &data)
 			node.PrintTrace("Mixed whitespace usage at line");
 	}
 }
+
+
+
+// Parse data in the binary encoding written by DataWriter. Each node is stored
+// as its depth and number of tokens, followed by the tokens. Each token is an
+// index into the table of strings read so far, and a new string (whose index is
+// the size of that table) is followed by its length and contents.
+void DataFile::LoadBinary(const string &data)
+{
+	size_t pos = BINARY_SIGNATURE.size();
+	if(pos >= data.size() || data[pos] != BINARY_VERSION)
+	{
+		root.PrintTrace("Error: unsupported version of binary data:");
+		return;
+	}
+	++pos;
+
+	vector<DataNode *> stack(1, &root);
+	vector<string> strings;
+	size_t lineNumber = 0;
+	while(pos < data.size())
+	{
+		++lineNumber;
+		size_t depth = 0;
+		size_t count = 0;
+		if(!ReadVarint(data, pos, depth) || !ReadVarint(data, pos, count) || depth >= stack.size())
+		{
+			root.PrintTrace("Error: malformed binary data at node " + to_string(lineNumber) + ":");
+			return;
+		}
+		stack.resize(depth + 1);
+
+		list<DataNode> &children = stack.back()->children;
+		children.emplace_back(stack.back());
+		DataNode &node = children.back();
+		node.lineNumber = lineNumber;
+		node.tokens.reserve(count);
+		stack.push_back(&node);
+
+		for(size_t i = 0; i < count; ++i)
+		{
+			size_t index = 0;
+			bool valid = ReadVarint(data, pos, index) && index <= strings.size();
+			if(valid && index == strings.size())
+			{
+				size_t length = 0;
+				valid = ReadVarint(data, pos, length) && length <= data.size() - pos;
+				if(valid)
+				{
+					strings.emplace_back(data, pos, length);
+					pos += length;
+				}
+			}
+			if(!valid)
+			{
+				root.PrintTrace("Error: malformed binary data at node " + to_string(lineNumber) + ":");
+				return;
+			}
+			node.tokens.push_back(strings[index]);
+		}
+	}
+}
@@ -31,6 +31,13 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 // just a collection of one or more tokens that can be interpreted either as
 // strings or as floating point values; see DataNode for more information.
 class DataFile {
+public:
+	// Data may also be stored in a compact binary encoding (see DataWriter),
+	// which is recognized by the signature and version at the start of it.
+	static const std::string BINARY_SIGNATURE;
+	static constexpr char BINARY_VERSION = 1;
+	static bool IsBinary(const std::string &data);
+
 public:
 	// A DataFile can be loaded either from a file path or an istream.
 	DataFile() = default;
@@ -47,6 +54,7 @@ public:
 
 private:
 	void LoadData(const std::string &data);
+	void LoadBinary(const std::string &data);
 
 
 private:
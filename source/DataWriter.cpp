@@ -15,11 +15,26 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DataWriter.h"
 
+#include "DataFile.h"
 #include "DataNode.h"
 #include "Files.h"
 
 using namespace std;
 
+namespace {
+	// Write an unsigned integer using seven bits per byte, with the high bit
+	// set on every byte but the last.
+	void WriteVarint(string &out, size_t value)
+	{
+		while(value >= 0x80)
+		{
+			out += static_cast<char>((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		out += static_cast<char>(value);
+	}
+}
+
 
 
 // This string constant is just used for remembering what string needs to be
@@ -42,6 +57,7 @@ DataWriter::DataWriter()
 	: before(&indent)
 {
 	out.precision(8);
+	number.precision(8);
 }
 
 
@@ -55,10 +71,31 @@ DataWriter::~DataWriter()
 
 
 
+// Write the compact binary encoding rather than text.
+void DataWriter::SetBinary()
+{
+	if(binary)
+		return;
+	binary = true;
+	out << DataFile::BINARY_SIGNATURE << DataFile::BINARY_VERSION;
+}
+
+
+
+bool DataWriter::IsBinary() const
+{
+	return binary;
+}
+
+
+
 // Save the contents to a file.
 void DataWriter::SaveToPath(const filesystem::path &filepath)
 {
-	Files::Write(filepath, out.str());
+	if(binary)
+		Files::WriteBinary(filepath, out.str());
+	else
+		Files::Write(filepath, out.str());
 }
 
 
@@ -96,6 +133,11 @@ void DataWriter::Write(const DataNode &node)
 // Begin a new line of the file.
 void DataWriter::Write()
 {
+	if(binary)
+	{
+		WriteBinaryLine();
+		return;
+	}
 	out << '\n';
 	before = &indent;
 }
@@ -121,6 +163,12 @@ void DataWriter::EndChild()
 // Write a comment line, at the current indentation level.
 void DataWriter::WriteComment(const string &str)
 {
+	// Comments are discarded when the data is read, so they are not worth storing.
+	if(binary)
+	{
+		Write();
+		return;
+	}
 	out << *before << "# " << str;
 	Write();
 }
@@ -138,6 +186,11 @@ void DataWriter::WriteToken(const char *a)
 // Write a token, given as a string object.
 void DataWriter::WriteToken(const string &a)
 {
+	if(binary)
+	{
+		WriteBinaryToken(a);
+		return;
+	}
 	out << *before;
 	out << Quote(a);
 
@@ -164,3 +217,41 @@ string DataWriter::Quote(const string &a)
 	else
 		return a;
 }
+
+
+
+// Add a token to the current line of the binary encoding. Each token is stored
+// as an index into the table of strings seen so far; a string that is not in
+// the table yet gets the next index, followed by its length and contents.
+void DataWriter::WriteBinaryToken(const string &token)
+{
+	auto it = strings.find(token);
+	if(it != strings.end())
+		WriteVarint(line, it->second);
+	else
+	{
+		size_t index = strings.size();
+		strings.emplace(token, index);
+		WriteVarint(line, index);
+		WriteVarint(line, token.size());
+		line += token;
+	}
+	++lineTokens;
+}
+
+
+
+// Finish the current line of the binary encoding: its indentation level and
+// number of tokens, followed by the tokens themselves.
+void DataWriter::WriteBinaryLine()
+{
+	if(!lineTokens)
+		return;
+
+	string header;
+	WriteVarint(header, indent.size());
+	WriteVarint(header, lineTokens);
+	out << header << line;
+	line.clear();
+	lineTokens = 0;
+}
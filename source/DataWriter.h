@@ -20,6 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class DataNode;
@@ -45,6 +46,12 @@ public:
 	// it possible to write the whole file in a single chunk.
 	~DataWriter();
 
+	// Write the compact binary encoding that DataFile also understands, rather
+	// than text. This must be chosen before anything has been written. Comments
+	// are not stored in the binary encoding.
+	void SetBinary();
+	bool IsBinary() const;
+
 	// Save the contents to a file.
 	void SaveToPath(const std::filesystem::path &path);
 	// Get the contents as a string.
@@ -94,6 +101,21 @@ private:
 	const std::string *before;
 	// Compose the output in memory before writing it to file.
 	std::ostringstream out;
+
+	// State for the binary encoding. Each line is composed separately because
+	// it must be preceded by its number of tokens, and each distinct string is
+	// only written out in full the first time it is used.
+	bool binary = false;
+	int lineTokens = 0;
+	std::string line;
+	std::unordered_map<std::string, size_t> strings;
+	// Used for formatting numeric tokens in the binary encoding.
+	std::ostringstream number;
+
+
+private:
+	void WriteBinaryToken(const std::string &token);
+	void WriteBinaryLine();
 };
 
 
@@ -116,6 +138,13 @@ void DataWriter::WriteToken(const A &a)
 	static_assert(std::is_arithmetic_v<A>,
 		"DataWriter cannot output anything but strings and arithmetic types.");
 
+	if(binary)
+	{
+		number.str(std::string());
+		number << a;
+		WriteBinaryToken(number.str());
+		return;
+	}
 	out << *before << a;
 	before = &space;
 }
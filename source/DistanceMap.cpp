@@ -23,8 +23,20 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "System.h"
 #include "Wormhole.h"
 
+#include <algorithm>
+
 using namespace std;
 
+namespace {
+	// Unfinished candidate Edges - Only the 'prev' value is up-to-date. Other
+	// values are one step behind, awaiting an update. This is a heap whose
+	// front is the best route among uncertain systems. Once popped, that's the
+	// best route to that system - and then adjacent links from that system are
+	// processed, which will build upon the popped Edge. Searches never nest,
+	// so every search on a thread reuses the same storage.
+	thread_local vector<RouteEdge> edgesTodo;
+}
+
 
 
 // Find paths from the given system. If the given maximum count is above zero,
@@ -102,7 +114,7 @@ DistanceMap::DistanceMap(const Ship &ship, const System &destination, const Play
 // Find out if the given system is reachable
 bool DistanceMap::HasRoute(const System &target) const
 {
-	return route.contains(&target);
+	return Find(target);
 }
 
 
@@ -110,8 +122,8 @@ bool DistanceMap::HasRoute(const System &target) const
 // Find out how many days away the given system is.
 int DistanceMap::Days(const System &target) const
 {
-	auto it = route.find(&target);
-	return (it == route.end() ? -1 : it->second.days);
+	const RouteEdge *edge = Find(target);
+	return (edge ? edge->days : -1);
 }
 
 
@@ -138,7 +150,7 @@ vector<const System *> DistanceMap::Plan(const System &target) const
 	while(nextStep != center)
 	{
 		plan.push_back(nextStep);
-		nextStep = route.at(nextStep).prev;
+		nextStep = Find(*nextStep)->prev;
 	}
 	return plan;
 }
@@ -153,9 +165,13 @@ void DistanceMap::Init(const Ship *ship)
 	if(!center || (ship && ship->IsRestrictedFrom(*center)) || center == destination)
 		return;
 
+	// Make room for every system up front, rather than growing the lookup table
+	// one system at a time as they are reached.
+	positions.resize(System::IndexLimit());
+
 	// To get to the starting point, there is no previous system,
 	// and it takes no fuel or days.
-	route[center] = RouteEdge();
+	SetRoute(*center, RouteEdge());
 	if(!maxDays)
 		return;
 
@@ -190,7 +206,8 @@ void DistanceMap::Init(const Ship *ship)
 	// jumps, break the tie by using how "dangerous" the route is.
 
 	// Add this fake edge "from center" so it's the first popped value.
-	edgesTodo.emplace(center);
+	edgesTodo.clear();
+	edgesTodo.emplace_back(center);
 	// Find all edges from that route, add better routes to the map, and continue.
 	while(maxSystems && !edgesTodo.empty())
 	{
@@ -201,8 +218,9 @@ void DistanceMap::Init(const Ship *ship)
 		// are built upon to determine if this new edge from 'prev' to 'X' is
 		// the best. If so, it's added as route[X], and a copy is added to
 		// edgesTodo to process later.
-		RouteEdge nextEdge = edgesTodo.top();
-		edgesTodo.pop();
+		pop_heap(edgesTodo.begin(), edgesTodo.end());
+		RouteEdge nextEdge = edgesTodo.back();
+		edgesTodo.pop_back();
 
 		const System *currentSystem = nextEdge.prev;
 
@@ -306,11 +324,22 @@ bool DistanceMap::Propagate(const RouteEdge &curEdge)
 
 
 
+// Get the best known path to the given system, or null if there is none.
+const RouteEdge *DistanceMap::Find(const System &to) const
+{
+	uint32_t index = to.Index();
+	if(index >= positions.size() || !positions[index])
+		return nullptr;
+	return &route[positions[index] - 1].second;
+}
+
+
+
 // Check if we already have a better path to the given system.
-bool DistanceMap::HasBetter(const System &to, const RouteEdge &edge)
+bool DistanceMap::HasBetter(const System &to, const RouteEdge &edge) const
 {
-	auto it = route.find(&to);
-	return (it != route.end() && !(it->second < edge));
+	const RouteEdge *existing = Find(to);
+	return (existing && !(*existing < edge));
 }
 
 
@@ -320,13 +349,33 @@ void DistanceMap::Add(const System &to, RouteEdge edge)
 {
 	// This is the best path we have found so far to this system, but it is
 	// conceivable that a better one will be found.
-	route[&to] = edge;
+	SetRoute(to, edge);
 
 	// Start building upon this edge and enqueue - this copy of edge
 	// is in an incomplete state and needs to be dequeued and worked on.
 	edge.prev = &to;
 	if(maxDays < 0 || edge.days < maxDays)
-		edgesTodo.emplace(edge);
+	{
+		edgesTodo.push_back(edge);
+		push_heap(edgesTodo.begin(), edgesTodo.end());
+	}
+}
+
+
+
+// Record the given path as the best known path to the given system.
+void DistanceMap::SetRoute(const System &to, const RouteEdge &edge)
+{
+	uint32_t index = to.Index();
+	if(index >= positions.size())
+		positions.resize(index + 1);
+	if(positions[index])
+		route[positions[index] - 1].second = edge;
+	else
+	{
+		route.emplace_back(&to, edge);
+		positions[index] = static_cast<uint32_t>(route.size());
+	}
 }
 
 
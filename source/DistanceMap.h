@@ -18,8 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "RouteEdge.h"
 #include "WormholeStrategy.h"
 
-#include <map>
-#include <queue>
+#include <cstdint>
 #include <set>
 #include <utility>
 #include <vector>
@@ -78,10 +77,14 @@ private:
 	void Init(const Ship *ship = nullptr);
 	// Add the given links to the map. Return false if an end condition is hit.
 	bool Propagate(const RouteEdge &curEdge);
+	// Get the best known path to the given system, or null if there is none.
+	const RouteEdge *Find(const System &to) const;
 	// Check if we already have a better path to the given system.
-	bool HasBetter(const System &to, const RouteEdge &edge);
+	bool HasBetter(const System &to, const RouteEdge &edge) const;
 	// Add the given path to the record.
 	void Add(const System &to, RouteEdge edge);
+	// Record the given path as the best known path to the given system.
+	void SetRoute(const System &to, const RouteEdge &edge);
 	// Check whether the given link is travelable. If no player was given in the
 	// constructor then this is always true; otherwise, the player must know
 	// that the given link exists.
@@ -90,15 +93,13 @@ private:
 
 private:
 	// Final route, each Edge pointing to the previous step along the route.
-	std::map<const System *, RouteEdge> route;
+	// Systems are listed in the order in which they were first reached.
+	std::vector<std::pair<const System *, RouteEdge>> route;
+	// For each System::Index(), one more than the position of that system
+	// in the route, or zero if it has not been reached.
+	std::vector<uint32_t> positions;
 
 	// Variables only used during construction:
-	// 'edgesTodo' holds unfinished candidate Edges - Only the 'prev' value
-	// is up-to-date. Other values are one step behind, awaiting an update.
-	// The top() value is the best route among uncertain systems. Once
-	// popped, that's the best route to that system - and then adjacent links
-	// from that system are processed, which will build upon the popped Edge.
-	std::priority_queue<RouteEdge> edgesTodo;
 	const PlayerInfo *player = nullptr;
 	const System *center = nullptr;
 	int maxSystems = -1;
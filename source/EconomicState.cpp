@@ -118,6 +118,8 @@ void SystemEconomy::Load(const DataNode &node)
 			tradeVolume = child.Value(1);
 		else if(key == "smuggling level" && child.Size() >= 2)
 			smugglingLevel = child.Value(1);
+		else if(key == "last update" && child.Size() >= 4)
+			lastUpdate = Date(child.Value(1), child.Value(2), child.Value(3));
 		else if(key == "news headline" && child.Size() >= 2)
 			newsHeadline = child.Token(1);
 		else if(key == "news date" && child.Size() >= 4)
@@ -207,6 +209,8 @@ void SystemEconomy::Save(DataWriter &out) const
 			out.Write("trade volume", tradeVolume);
 		if(smugglingLevel > 0.01)
 			out.Write("smuggling level", smugglingLevel);
+		if(lastUpdate)
+			out.Write("last update", lastUpdate.Day(), lastUpdate.Month(), lastUpdate.Year());
 
 		if(!newsHeadline.empty())
 		{
@@ -267,6 +271,7 @@ void SystemEconomy::Clear()
 	pirateLosses = 0.0;
 	tradeVolume = 0.0;
 	smugglingLevel = 0.0;
+	lastUpdate = Date();
 	recentEvents.clear();
 	newsHeadline.clear();
 	newsDate = Date();
@@ -468,10 +473,7 @@ void SystemEconomy::RecordEvent(EconomicEventType type, int magnitude,
 
 bool SystemEconomy::StepDaily(const Date &date, const System *system)
 {
-	merchantLosses *= DAILY_COUNTER_DECAY;
-	pirateLosses *= DAILY_COUNTER_DECAY;
-	tradeVolume *= DAILY_COUNTER_DECAY;
-	smugglingLevel *= DAILY_COUNTER_DECAY;
+	CatchUp(date);
 
 	SimulateNPCActivity(date, system);
 
@@ -486,6 +488,33 @@ bool SystemEconomy::StepDaily(const Date &date, const System *system)
 
 
 
+void SystemEconomy::CatchUp(const Date &date)
+{
+	if(!date)
+		return;
+	if(!lastUpdate)
+	{
+		lastUpdate = date;
+		return;
+	}
+	int days = date - lastUpdate;
+	if(days <= 0)
+		return;
+
+	// Decaying a counter for many days at once is the same as decaying it once
+	// per day. For a single day, this is exactly the same multiplication.
+	double decay = pow(DAILY_COUNTER_DECAY, days);
+	merchantLosses *= decay;
+	pirateLosses *= decay;
+	tradeVolume *= decay;
+	smugglingLevel *= decay;
+	lastUpdate = date;
+	// A change is only significant on the day it happens.
+	significantChange = false;
+}
+
+
+
 void SystemEconomy::SetState(EconomicStateType newState, const string &commodity, int strength)
 {
 	if(state != newState)
@@ -505,30 +534,30 @@ void SystemEconomy::SetState(EconomicStateType newState, const string &commodity
 
 
 
-int SystemEconomy::GetMerchantLosses() const
+int SystemEconomy::GetMerchantLosses(const Date &date) const
 {
-	return static_cast<int>(merchantLosses);
+	return static_cast<int>(Decayed(merchantLosses, date));
 }
 
 
 
-int SystemEconomy::GetPirateLosses() const
+int SystemEconomy::GetPirateLosses(const Date &date) const
 {
-	return static_cast<int>(pirateLosses);
+	return static_cast<int>(Decayed(pirateLosses, date));
 }
 
 
 
-int SystemEconomy::GetTradeVolume() const
+int SystemEconomy::GetTradeVolume(const Date &date) const
 {
-	return static_cast<int>(tradeVolume);
+	return static_cast<int>(Decayed(tradeVolume, date));
 }
 
 
 
-int SystemEconomy::GetSmugglingLevel() const
+int SystemEconomy::GetSmugglingLevel(const Date &date) const
 {
-	return static_cast<int>(smugglingLevel);
+	return static_cast<int>(Decayed(smugglingLevel, date));
 }
 
 
@@ -540,9 +569,10 @@ const vector<EconomicEvent> &SystemEconomy::GetRecentEvents() const
 
 
 
-bool SystemEconomy::HasSignificantChange() const
+bool SystemEconomy::HasSignificantChange(const Date &date) const
 {
-	return significantChange;
+	// A change is only significant on the day it happens.
+	return significantChange && (!date || !lastUpdate || date <= lastUpdate);
 }
 
 
@@ -737,6 +767,17 @@ void SystemEconomy::SimulateNPCActivity(const Date &date, const System *system)
 
 
 
+// Get the value of a rolling counter on the given date, without storing it.
+double SystemEconomy::Decayed(double counter, const Date &date) const
+{
+	if(!date || !lastUpdate)
+		return counter;
+	int days = date - lastUpdate;
+	return days > 0 ? counter * pow(DAILY_COUNTER_DECAY, days) : counter;
+}
+
+
+
 void SystemEconomy::GenerateNewsHeadline(EconomicStateType oldState, EconomicStateType newState,
 	const System *system)
 {
@@ -790,7 +831,7 @@ void EconomicManager::Load(const DataNode &node)
 				for(const DataNode &grand : child)
 				{
 					if(grand.Token(0) == "economy")
-						systemEconomies[system].Load(grand);
+						GetSystemEconomy(system).Load(grand);
 				}
 			}
 		}
@@ -823,9 +864,9 @@ void EconomicManager::Save(DataWriter &out) const
 		for(const auto &pair : systemEconomies)
 		{
 			if(pair.second.GetState() != EconomicStateType::STABLE ||
-				pair.second.GetMerchantLosses() > 0 ||
-				pair.second.GetPirateLosses() > 0 ||
-				pair.second.GetTradeVolume() > 0)
+				pair.second.GetMerchantLosses(today) > 0 ||
+				pair.second.GetPirateLosses(today) > 0 ||
+				pair.second.GetTradeVolume(today) > 0)
 			{
 				out.Write("system", pair.first->TrueName());
 				out.BeginChild();
@@ -842,6 +883,10 @@ void EconomicManager::Save(DataWriter &out) const
 void EconomicManager::Clear()
 {
 	systemEconomies.clear();
+	positions.clear();
+	active.clear();
+	isActive.clear();
+	today = Date();
 	blackMarketSystems.clear();
 }
 
@@ -849,33 +894,69 @@ void EconomicManager::Clear()
 
 vector<string> EconomicManager::StepDaily(const Date &date)
 {
+	today = date;
+
 	vector<string> news;
-	for(auto &pair : systemEconomies)
+	vector<uint32_t> stepping;
+	stepping.swap(active);
+	for(uint32_t position : stepping)
 	{
-		bool changed = pair.second.StepDaily(date, pair.first);
+		isActive[position] = false;
+		auto &[system, economy] = systemEconomies[position];
+		bool changed = economy.StepDaily(date, system);
 		if(changed)
 		{
-			const string &headline = pair.second.GetNewsHeadline();
+			const string &headline = economy.GetNewsHeadline();
 			if(!headline.empty())
 				news.push_back(headline);
 		}
+		// A STABLE economy stays that way until something happens to it.
+		if(economy.GetState() != EconomicStateType::STABLE)
+		{
+			isActive[position] = true;
+			active.push_back(position);
+		}
 	}
 	return news;
 }
 
 
 
+// Anyone who gets a modifiable economy may change it, so it is brought up to
+// date and stepped on the next day.
 SystemEconomy &EconomicManager::GetSystemEconomy(const System *system)
 {
-	return systemEconomies[system];
+	uint32_t position = Position(system);
+	if(!isActive[position])
+	{
+		isActive[position] = true;
+		active.push_back(position);
+	}
+	SystemEconomy &economy = systemEconomies[position].second;
+	economy.CatchUp(today);
+	return economy;
 }
 
 
 
 const SystemEconomy *EconomicManager::GetSystemEconomy(const System *system) const
 {
-	auto it = systemEconomies.find(system);
-	return (it != systemEconomies.end()) ? &it->second : nullptr;
+	uint32_t index = system->Index();
+	if(index >= positions.size() || !positions[index])
+		return nullptr;
+	return &systemEconomies[positions[index] - 1].second;
+}
+
+
+
+// Reading an economy must not change how it is simulated, so unlike the
+// modifiable lookup, this does not mark the economy to be stepped.
+const SystemEconomy &EconomicManager::ReadSystemEconomy(const System *system) const
+{
+	static const SystemEconomy stable;
+
+	const SystemEconomy *economy = GetSystemEconomy(system);
+	return economy ? *economy : stable;
 }
 
 
@@ -886,7 +967,7 @@ void EconomicManager::RecordEvent(const System *system, EconomicEventType type,
 	if(!system)
 		return;
 
-	SystemEconomy &economy = systemEconomies[system];
+	SystemEconomy &economy = GetSystemEconomy(system);
 	economy.RecordEvent(type, magnitude, commodity, playerCaused);
 
 	bool shouldCascade = false;
@@ -984,3 +1065,19 @@ double EconomicManager::GetBlackMarketModifier() const
 {
 	return blackMarketModifier;
 }
+
+
+
+uint32_t EconomicManager::Position(const System *system)
+{
+	uint32_t index = system->Index();
+	if(index >= positions.size())
+		positions.resize(index + 1);
+	if(!positions[index])
+	{
+		systemEconomies.emplace_back(system, SystemEconomy());
+		isActive.push_back(false);
+		positions[index] = static_cast<uint32_t>(systemEconomies.size());
+	}
+	return positions[index] - 1;
+}
@@ -18,9 +18,10 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Date.h"
 
 #include <cstdint>
-#include <map>
+#include <deque>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 class DataNode;
@@ -166,22 +167,27 @@ public:
 	// Called once per day to update state and counters.
 	// Returns true if state changed.
 	bool StepDaily(const Date &date, const System *system);
+	// Decay the rolling counters for each day since they were last updated,
+	// without simulating anything else for those days. This is part of the
+	// simulation, so it is only done before an economy is stepped or changed.
+	void CatchUp(const Date &date);
 
 	// Force a state change (for events, missions, etc.).
 	void SetState(EconomicStateType state, const std::string &commodity = "",
 		int strength = 100);
 
-	// Get rolling counters for state transition logic.
-	int GetMerchantLosses() const;
-	int GetPirateLosses() const;
-	int GetTradeVolume() const;
-	int GetSmugglingLevel() const;
+	// Get rolling counters for state transition logic, as of the given date.
+	// Any decay since they were last updated is included, but not stored.
+	int GetMerchantLosses(const Date &date) const;
+	int GetPirateLosses(const Date &date) const;
+	int GetTradeVolume(const Date &date) const;
+	int GetSmugglingLevel(const Date &date) const;
 
 	// Get recent events.
 	const std::vector<EconomicEvent> &GetRecentEvents() const;
 
-	// Check if an event is significant enough to report.
-	bool HasSignificantChange() const;
+	// Check if an event on the given date is significant enough to report.
+	bool HasSignificantChange(const Date &date) const;
 
 	// Get the last significant news headline for this system.
 	const std::string &GetNewsHeadline() const;
@@ -202,6 +208,9 @@ private:
 	// Simulate NPC economic activity (trade, piracy, etc.).
 	void SimulateNPCActivity(const Date &date, const System *system);
 
+	// Get the value of a rolling counter on the given date.
+	double Decayed(double counter, const Date &date) const;
+
 	// Generate news headline for state change.
 	void GenerateNewsHeadline(EconomicStateType oldState, EconomicStateType newState,
 		const System *system);
@@ -214,11 +223,13 @@ private:
 	int stateStrength = 0;          // How entrenched the state is (0-100)
 	Date stateChangeDate;           // When state last changed
 
-	// Rolling counters (decay daily).
+	// Rolling counters (decay daily), as of the date they were last updated.
+	// The decay is applied lazily, by CatchUp().
 	double merchantLosses = 0.0;
 	double pirateLosses = 0.0;
 	double tradeVolume = 0.0;
 	double smugglingLevel = 0.0;
+	Date lastUpdate;
 
 	// Event history.
 	std::vector<EconomicEvent> recentEvents;
@@ -230,7 +241,7 @@ private:
 	// Configuration (shared across systems, but can be overridden).
 	EconomicConfig config;
 
-	// Whether there was a significant change recently.
+	// Whether there was a significant change on the day of the last update.
 	bool significantChange = false;
 };
 
@@ -252,9 +263,17 @@ public:
 	// Called once per day to update all systems. Returns news headlines for display.
 	std::vector<std::string> StepDaily(const Date &date);
 
-	// Get the economy for a specific system.
+	// Get the economy for a specific system, to modify it. The economy is
+	// created if needed, and will be stepped on the next day.
 	SystemEconomy &GetSystemEconomy(const System *system);
+	// Get the economy for a specific system, or nullptr if the system has no
+	// economy yet. It is not brought up to date; its counters can be read as of
+	// any date instead.
 	const SystemEconomy *GetSystemEconomy(const System *system) const;
+	// Get the economy for a specific system for display. This never creates
+	// an economy or causes it to be stepped; a system with no economy reports
+	// a STABLE one.
+	const SystemEconomy &ReadSystemEconomy(const System *system) const;
 
 	// Record an event in a system (convenience method).
 	void RecordEvent(const System *system, EconomicEventType type,
@@ -281,8 +300,24 @@ public:
 
 
 private:
-	// Per-system economy state.
-	std::map<const System *, SystemEconomy> systemEconomies;
+	// Get the position of the given system's economy, creating it if needed.
+	uint32_t Position(const System *system);
+
+
+private:
+	// Per-system economy state, in the order the systems were first added.
+	// Adding a system does not move the others, so references stay valid.
+	std::deque<std::pair<const System *, SystemEconomy>> systemEconomies;
+	// For each System::Index(), one more than the position of its economy, or
+	// zero if it has none.
+	std::vector<uint32_t> positions;
+	// The economies that must be stepped on the next day: those that are not
+	// STABLE, and those that may have changed since they were last stepped.
+	// The others do nothing but decay, so that is done when they are next used.
+	std::vector<uint32_t> active;
+	std::vector<bool> isActive;
+	// The last day that the economies were stepped to.
+	Date today;
 
 	// Default configuration.
 	EconomicConfig defaultConfig;
@@ -20,7 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "ShipEvent.h"
 
 #include <algorithm>
-#include <map>
+#include <functional>
 
 using namespace std;
 
@@ -309,7 +309,7 @@ EncounterLog::EncounterLog(size_t maxRecords)
 
 void EncounterLog::Load(const DataNode &node)
 {
-	records.clear();
+	Clear();
 
 	for(const DataNode &child : node)
 	{
@@ -319,11 +319,24 @@ void EncounterLog::Load(const DataNode &node)
 		{
 			EncounterRecord record;
 			record.Load(child);
-
-			if(!record.npcUuid.empty())
-				records[record.npcUuid] = std::move(record);
+			if(record.npcUuid.empty())
+				continue;
+
+			// A later record for the same NPC replaces the earlier one.
+			EsUuid::Key key = KeyOf(record.npcUuid);
+			auto it = index.find(key);
+			if(it != index.end())
+				*it->second = std::move(record);
+			else
+				index.emplace(key, records.insert(records.end(), std::move(record)));
 		}
 	}
+
+	// Restore the least-recently-seen order. Older saves wrote the records in
+	// order of their UUIDs, and the sort is stable, so a save written by this
+	// version keeps the order it was written in.
+	records.sort([](const EncounterRecord &a, const EncounterRecord &b) { return a.lastSeen < b.lastSeen; });
+	TrimToMaxSize();
 }
 
 
@@ -335,8 +348,8 @@ void EncounterLog::Save(DataWriter &out) const
 	{
 		out.Write("max records", maxRecords);
 
-		for(const auto &pair : records)
-			pair.second.Save(out);
+		for(const EncounterRecord &record : records)
+			record.Save(out);
 	}
 	out.EndChild();
 }
@@ -346,6 +359,7 @@ void EncounterLog::Save(DataWriter &out) const
 void EncounterLog::Clear()
 {
 	records.clear();
+	index.clear();
 }
 
 
@@ -353,42 +367,48 @@ void EncounterLog::Clear()
 EncounterRecord &EncounterLog::GetOrCreate(const string &uuid, const Date &date,
 	const string &system)
 {
-	auto it = records.find(uuid);
-	if(it != records.end())
-	{
-		it->second.RecordEncounter(date, system);
-		return it->second;
-	}
+	return GetOrCreate(KeyOf(uuid), nullptr, uuid, date, system);
+}
 
-	// Create new record.
-	EncounterRecord record(date, system, uuid);
-	auto result = records.emplace(uuid, std::move(record));
 
-	TrimToMaxSize();
 
-	return result.first->second;
+EncounterRecord &EncounterLog::GetOrCreate(const EsUuid &uuid, const Date &date,
+	const string &system)
+{
+	return GetOrCreate(uuid.ToKey(), &uuid, string(), date, system);
 }
 
 
 
 const EncounterRecord *EncounterLog::Get(const string &uuid) const
 {
-	auto it = records.find(uuid);
-	return (it != records.end()) ? &it->second : nullptr;
+	return Get(KeyOf(uuid));
+}
+
+
+
+const EncounterRecord *EncounterLog::Get(const EsUuid &uuid) const
+{
+	return Get(uuid.ToKey());
 }
 
 
 
 bool EncounterLog::HasRecord(const string &uuid) const
 {
-	return records.count(uuid) > 0;
+	return index.count(KeyOf(uuid));
 }
 
 
 
 void EncounterLog::Remove(const string &uuid)
 {
-	records.erase(uuid);
+	auto it = index.find(KeyOf(uuid));
+	if(it == index.end())
+		return;
+
+	records.erase(it->second);
+	index.erase(it);
 }
 
 
@@ -396,9 +416,9 @@ void EncounterLog::Remove(const string &uuid)
 vector<const EncounterRecord *> EncounterLog::GetByDisposition(NPCDisposition disposition) const
 {
 	vector<const EncounterRecord *> result;
-	for(const auto &pair : records)
-		if(pair.second.GetDisposition() == disposition)
-			result.push_back(&pair.second);
+	for(const EncounterRecord &record : records)
+		if(record.GetDisposition() == disposition)
+			result.push_back(&record);
 	return result;
 }
 
@@ -407,9 +427,9 @@ vector<const EncounterRecord *> EncounterLog::GetByDisposition(NPCDisposition di
 vector<const EncounterRecord *> EncounterLog::GetBySystem(const string &system) const
 {
 	vector<const EncounterRecord *> result;
-	for(const auto &pair : records)
-		if(pair.second.lastSystem == system)
-			result.push_back(&pair.second);
+	for(const EncounterRecord &record : records)
+		if(record.lastSystem == system)
+			result.push_back(&record);
 	return result;
 }
 
@@ -437,21 +457,56 @@ void EncounterLog::SetMaxRecords(size_t max)
 
 
 
-void EncounterLog::TrimToMaxSize()
+EsUuid::Key EncounterLog::KeyOf(const string &uuid)
 {
-	if(records.size() <= maxRecords)
-		return;
+	EsUuid::Key key;
+	// Valid version 4 UUIDs never have an all-zero second half, so hashed text
+	// cannot be mistaken for one.
+	if(!EsUuid::ParseKey(uuid, key))
+		key = EsUuid::Key{hash<string>()(uuid), 0};
+	return key;
+}
+
 
-	// Find and remove the oldest (by lastSeen) records until we're under the limit.
+
+EncounterRecord &EncounterLog::GetOrCreate(const EsUuid::Key &key, const EsUuid *uuid, const string &text,
+	const Date &date, const string &system)
+{
+	auto it = index.find(key);
+	if(it != index.end())
+	{
+		// Seeing this NPC again makes it the most recently seen record.
+		records.splice(records.end(), records, it->second);
+		it->second->RecordEncounter(date, system);
+		return *it->second;
+	}
+
+	// Create new record. The text of the UUID is only needed for new records.
+	auto record = records.emplace(records.end(), date, system, uuid ? uuid->ToString() : text);
+	index.emplace(key, record);
+
+	TrimToMaxSize();
+
+	return *record;
+}
+
+
+
+const EncounterRecord *EncounterLog::Get(const EsUuid::Key &key) const
+{
+	auto it = index.find(key);
+	return (it != index.end()) ? &*it->second : nullptr;
+}
+
+
+
+void EncounterLog::TrimToMaxSize()
+{
+	// Remove the least recently seen records until we're under the limit.
 	while(records.size() > maxRecords)
 	{
-		auto oldest = records.begin();
-		for(auto it = records.begin(); it != records.end(); ++it)
-		{
-			if(it->second.lastSeen < oldest->second.lastSeen)
-				oldest = it;
-		}
-		records.erase(oldest);
+		index.erase(KeyOf(records.front().npcUuid));
+		records.pop_front();
 	}
 }
 
@@ -16,10 +16,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "Date.h"
+#include "EsUuid.h"
 
 #include <cstdint>
-#include <map>
+#include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class DataNode;
@@ -133,6 +135,9 @@ struct EncounterRecord {
 
 // Manager class for a collection of encounter records.
 // This is typically owned by PlayerInfo to track all NPC encounters.
+// Records are kept in the order they were last seen, so the least recently
+// seen record can be dropped in constant time once the log is full, and they
+// are indexed by the binary value of their UUID rather than its text.
 class EncounterLog {
 public:
 	// Default maximum number of records to keep.
@@ -158,9 +163,12 @@ public:
 	// Get or create an encounter record for a specific NPC UUID.
 	EncounterRecord &GetOrCreate(const std::string &uuid, const Date &date,
 		const std::string &system = "");
+	EncounterRecord &GetOrCreate(const EsUuid &uuid, const Date &date,
+		const std::string &system = "");
 
 	// Get a record if it exists (const version, returns nullptr if not found).
 	const EncounterRecord *Get(const std::string &uuid) const;
+	const EncounterRecord *Get(const EsUuid &uuid) const;
 
 	// Check if we have a record for this NPC.
 	bool HasRecord(const std::string &uuid) const;
@@ -183,11 +191,23 @@ public:
 
 
 private:
+	using Index = std::unordered_map<EsUuid::Key, std::list<EncounterRecord>::iterator, EsUuid::Key::Hash>;
+
+	// Get the key for the given UUID text. Text that is not a valid UUID is
+	// hashed instead, so that any string can still be used to identify a record.
+	static EsUuid::Key KeyOf(const std::string &uuid);
+
+	EncounterRecord &GetOrCreate(const EsUuid::Key &key, const EsUuid *uuid, const std::string &text,
+		const Date &date, const std::string &system);
+	const EncounterRecord *Get(const EsUuid::Key &key) const;
+
 	// Trim the log to maximum size, removing least-recently-seen entries.
 	void TrimToMaxSize();
 
-	// Map from NPC UUID to encounter record.
-	std::map<std::string, EncounterRecord> records;
+	// The encounter records, from least to most recently seen.
+	std::list<EncounterRecord> records;
+	// Map from the value of each NPC's UUID to its record.
+	Index index;
 
 	// Maximum number of records to retain.
 	size_t maxRecords = DEFAULT_MAX_RECORDS;
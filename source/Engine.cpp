@@ -33,6 +33,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "text/Font.h"
 #include "text/FontSet.h"
 #include "text/Format.h"
+#include "FrameArena.h"
 #include "FrameTimer.h"
 #include "GameData.h"
 #include "Gamerules.h"
@@ -312,6 +313,7 @@ Engine::~Engine()
 void Engine::Place()
 {
 	ships.clear();
+	shipSlots.Clear();
 	ai.ClearOrders();
 
 	player.SetSystemEntry(SystemEntry::TAKE_OFF);
@@ -321,7 +323,10 @@ void Engine::Place()
 	// code already took care of loading up fighters and assigning parents.
 	for(const shared_ptr<Ship> &ship : player.Ships())
 		if(!ship->IsParked() && ship->GetSystem())
+		{
 			ships.push_back(ship);
+			AddShipSlot(*ship);
+		}
 
 	// Add NPCs to the list of ships. Fighters have to be assigned to carriers,
 	// and all but "uninterested" ships should follow the player.
@@ -395,6 +400,8 @@ void Engine::Place()
 	}
 	// Move any ships that were randomly spawned into the main list, now
 	// that all special ships have been repositioned.
+	for(const shared_ptr<Ship> &ship : newShips)
+		AddShipSlot(*ship);
 	ships.splice(ships.end(), newShips);
 
 	camera.SnapTo(flagship->Center());
@@ -464,6 +471,7 @@ void Engine::Place(const list<NPC> &npcs, const shared_ptr<Ship> &flagship)
 			}
 
 			ships.push_back(ship);
+			AddShipSlot(*ship);
 			// The first (alive) ship in an NPC block
 			// serves as the flagship of the group.
 			if(!npcFlagship)
@@ -507,7 +515,7 @@ void Engine::Step(bool isActive)
 		if(report.victimGov)
 		{
 			// Use the standard offense mechanism, which propagates to allied governments.
-			report.victimGov->Offend(report.eventType, 1);
+			report.victimGov->Offend(report.eventType, report.count);
 
 			// Notify the player that their crime was reported.
 			string message = "Witnesses have reported your crime against the " +
@@ -753,7 +761,7 @@ void Engine::Step(bool isActive)
 		Messages::Add(*GameData::Messages().Get("overheated"));
 
 	// Clear the HUD information from the previous frame.
-	info = Information();
+	info.Clear();
 	if(flagship && flagship->Hull())
 	{
 		Point shipFacingUnit(0., -1.);
@@ -1280,8 +1288,8 @@ void Engine::Draw() const
 	Point messagePoint{messageBox.Left(), messagesReversed ? messageBox.Top() : messageBox.Bottom()};
 	for(auto it = messages.rbegin(); it != messages.rend(); ++it)
 	{
-		messageLine.Wrap(it->message);
-		int height = messageLine.Height();
+		const WrappedText &layout = it->layout.Get(it->message, messageLine);
+		int height = layout.Height();
 		if(messagesReversed && it == messages.rbegin())
 			messagePoint.Y() -= height;
 		// Dying messages are those scheduled for removal as duplicates.
@@ -1306,7 +1314,7 @@ void Engine::Draw() const
 		}
 		float alpha = isAnimating ? isDying ? min<double>(messageAnimation(age), naturalDecay(naturalAge))
 			: messageAnimation(age) : naturalDecay(age);
-		messageLine.Draw(messagePoint, it->category->MainColor().Additive(alpha));
+		layout.Draw(messagePoint, it->category->MainColor().Additive(alpha));
 	}
 
 	// Draw crosshairs around anything that is targeted.
@@ -1371,6 +1379,12 @@ void Engine::Draw() const
 		Color color = *colors.Get("medium");
 		font.Draw(loadString,
 			Point(-10 - font.Width(loadString), Screen::Height() * -.5 + 5.), color);
+		// Show how many allocations the last step made, and how many of them
+		// could not be served by the frame arena.
+		string allocString = to_string(FrameArena::Allocations()) + " allocs, "
+			+ to_string(FrameArena::HeapAllocations()) + " from heap";
+		font.Draw(allocString,
+			Point(-10 - font.Width(allocString), Screen::Height() * -.5 + 25.), color);
 	}
 }
 
@@ -1578,7 +1592,7 @@ void Engine::EnterSystem()
 	grudge.clear();
 
 	projectiles.clear();
-	visuals.clear();
+	visuals.Clear();
 	flotsam.clear();
 	// Cancel any projectiles, visuals, or flotsam created by ships this step.
 	newProjectiles.clear();
@@ -1613,6 +1627,8 @@ void Engine::EnterSystem()
 void Engine::CalculateStep()
 {
 	FrameTimer loadTimer;
+	// Containers that only live for this step get their memory from the frame arena.
+	FrameArena::Frame frame;
 
 	// If there is a pending zoom update then use it
 	// because the zoom will get updated in the main thread
@@ -1729,8 +1745,7 @@ void Engine::CalculateStep()
 	for(const Projectile &projectile : projectiles)
 		batchDraw[currentCalcBuffer].Add(projectile, projectile.Clip());
 	// Draw the visuals.
-	for(const Visual &visual : visuals)
-		batchDraw[currentCalcBuffer].AddVisual(visual);
+	visuals.Draw(batchDraw[currentCalcBuffer]);
 
 	// Keep track of how much of the CPU time we are using.
 	loadSum += loadTimer.Time();
@@ -1793,6 +1808,9 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	// If the flagship just began jumping, play the appropriate sound.
 	if(!wasHyperspacing && flagship && flagship->IsEnteringHyperspace())
 	{
+		// The jump will end on a new day, so start working out that day's
+		// trade while the flagship is still in hyperspace.
+		GameData::PrepareEconomy();
 		bool isJumping = flagship->IsUsingJumpDrive();
 		const map<const Sound *, int> &jumpSounds = isJumping
 			? flagship->Attributes().JumpSounds() : flagship->Attributes().HyperSounds();
@@ -1828,7 +1846,13 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 		player.SetSystem(*playerSystem);
 		EnterSystem();
 	}
-	PrunePointers(ships);
+	erase_if(ships, [this](const shared_ptr<Ship> &ship)
+	{
+		if(!ship->ShouldBeRemoved())
+			return false;
+		RemoveShipSlot(*ship);
+		return true;
+	});
 
 	// Move the asteroids. This must be done before collision detection. Minables
 	// may create visuals or flotsam.
@@ -1842,7 +1866,10 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 
 	// Move the projectiles.
 	for(Projectile &projectile : projectiles)
-		projectile.Move(newVisuals, newProjectiles);
+		projectile.Move(newVisuals, newProjectiles, shipSlots);
+	// The order of the projectiles decides the order they are drawn in and in
+	// which their collisions are resolved, so it must be kept. Pruning compacts
+	// the list in a single pass, moving each surviving projectile at most once.
 	Prune(projectiles);
 
 	// Step the weather.
@@ -1851,9 +1878,7 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	Prune(activeWeather);
 
 	// Move the visuals.
-	for(Visual &visual : visuals)
-		visual.Move();
-	Prune(visuals);
+	visuals.Move();
 
 	// Perform various minor actions.
 	SpawnFleets();
@@ -1867,10 +1892,12 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	// be drawn this step (and the projectiles will participate in collision
 	// detection) but they should not be moved, which is why we put off adding
 	// them to the lists until now.
+	for(const shared_ptr<Ship> &ship : newShips)
+		AddShipSlot(*ship);
 	ships.splice(ships.end(), newShips);
 	Append(projectiles, newProjectiles);
 	flotsam.splice(flotsam.end(), newFlotsam);
-	Append(visuals, newVisuals);
+	visuals.Append(newVisuals);
 
 	// Decrement the count of how long it's been since a ship last asked for help.
 	if(grudgeTime)
@@ -1901,6 +1928,9 @@ void Engine::CalculateUnpaused(const Ship *flagship, const System *playerSystem)
 	// Check for ship scanning.
 	for(const shared_ptr<Ship> &it : ships)
 		DoScanning(it);
+
+	// Visuals created by collisions are drawn this step, but not moved.
+	visuals.Append(newVisuals);
 }
 
 
@@ -2031,6 +2061,33 @@ void Engine::MoveShip(const shared_ptr<Ship> &ship)
 
 
 
+// Give a ship that is entering the list of ships a handle, unless it still has
+// a valid one (e.g. a fighter that is being launched again).
+void Engine::AddShipSlot(Ship &ship)
+{
+	const Ship *const *slot = shipSlots.Get(ship.Handle());
+	if(!slot || *slot != &ship)
+		ship.SetHandle(shipSlots.Insert(&ship));
+}
+
+
+
+// Release the handle of a ship that is leaving the list of ships. Ships that are
+// docked in a carrier keep their handle, so that the AI still remembers what
+// they did once they are launched again; they are released along with their carrier.
+void Engine::RemoveShipSlot(Ship &ship)
+{
+	if(!ship.GetSystem() && ship.GetParent())
+		return;
+
+	shipSlots.Erase(ship.Handle());
+	for(const Ship::Bay &bay : ship.Bays())
+		if(bay.ship)
+			shipSlots.Erase(bay.ship->Handle());
+}
+
+
+
 // Populate the ship collision detection set for projectile & flotsam computations.
 void Engine::FillCollisionSets()
 {
@@ -2421,15 +2478,16 @@ void Engine::HandleMouseInput(Command &activeCommands)
 
 
 
-// Perform collision detection. Note that unlike the preceding functions, this
-// one adds any visuals that are created directly to the main visuals list. If
-// this is multi-threaded in the future, that will need to change.
+// Perform collision detection. Any visuals that are created here are added to
+// the main visuals list once all collisions have been handled, so that they are
+// drawn this step without being moved. If this is multi-threaded in the future,
+// that will need to change.
 void Engine::DoCollisions(Projectile &projectile)
 {
 	// The asteroids can collide with projectiles, the same as any other
 	// object. If the asteroid turns out to be closer than the ship, it
 	// shields the ship (unless the projectile has a blast radius).
-	vector<Collision> collisions;
+	collisions.clear();
 	const Government *gov = projectile.GetGovernment();
 	const Weapon &weapon = projectile.GetWeapon();
 
@@ -2455,10 +2513,9 @@ void Engine::DoCollisions(Projectile &projectile)
 		double triggerRadius = weapon.TriggerRadius();
 		if(triggerRadius)
 		{
-			vector<Body *> inRadius;
-			inRadius.reserve(min(static_cast<vector<Body *>::size_type>(triggerRadius), ships.size()));
-			shipCollisions.Circle(projectile.Position(), triggerRadius, inRadius);
-			for(const Body *body : inRadius)
+			nearbyBodies.clear();
+			shipCollisions.Circle(projectile.Position(), triggerRadius, nearbyBodies);
+			for(const Body *body : nearbyBodies)
 			{
 				const Ship *ship = reinterpret_cast<const Ship *>(body);
 				if(body == projectile.Target() || (gov->IsEnemy(body->GetGovernment())
@@ -2507,7 +2564,7 @@ void Engine::DoCollisions(Projectile &projectile)
 
 		// Create the explosion the given distance along the projectile's
 		// motion path for this step.
-		projectile.Explode(visuals, range, hit ? hit->Velocity() : Point());
+		projectile.Explode(newVisuals, range, hit ? hit->Velocity() : Point());
 
 		const DamageProfile damage(projectile.GetInfo(range));
 
@@ -2520,10 +2577,9 @@ void Engine::DoCollisions(Projectile &projectile)
 			// "safe" weapon.
 			Point hitPos = projectile.Position() + range * projectile.Velocity();
 			bool isSafe = weapon.IsSafe();
-			vector<Body *> blastCollisions;
-			blastCollisions.reserve(32);
-			shipCollisions.Circle(hitPos, blastRadius, blastCollisions);
-			for(Body *body : blastCollisions)
+			nearbyBodies.clear();
+			shipCollisions.Circle(hitPos, blastRadius, nearbyBodies);
+			for(Body *body : nearbyBodies)
 			{
 				Ship *ship = reinterpret_cast<Ship *>(body);
 				bool targeted = (projectile.Target() == ship);
@@ -2532,14 +2588,14 @@ void Engine::DoCollisions(Projectile &projectile)
 					continue;
 
 				// Only directly targeted ships get provoked by blast weapons.
-				int eventType = ship->TakeDamage(visuals, damage.CalculateDamage(*ship, ship == hit),
+				int eventType = ship->TakeDamage(newVisuals, damage.CalculateDamage(*ship, ship == hit),
 					targeted ? gov : nullptr);
 				if(eventType)
 					eventQueue.emplace_back(gov, ship->shared_from_this(), eventType);
 			}
-			blastCollisions.clear();
-			asteroids.MinablesCollisionsCircle(hitPos, blastRadius, blastCollisions);
-			for(Body *body : blastCollisions)
+			nearbyBodies.clear();
+			asteroids.MinablesCollisionsCircle(hitPos, blastRadius, nearbyBodies);
+			for(Body *body : nearbyBodies)
 			{
 				auto minable = reinterpret_cast<Minable *>(body);
 				minable->TakeDamage(damage.CalculateDamage(*minable));
@@ -2549,7 +2605,7 @@ void Engine::DoCollisions(Projectile &projectile)
 		{
 			if(collisionType == CollisionType::SHIP)
 			{
-				int eventType = shipHit->TakeDamage(visuals, damage.CalculateDamage(*shipHit), gov);
+				int eventType = shipHit->TakeDamage(newVisuals, damage.CalculateDamage(*shipHit), gov);
 				if(eventType)
 				{
 					eventQueue.emplace_back(gov, shipHit, eventType);
@@ -2559,7 +2615,7 @@ void Engine::DoCollisions(Projectile &projectile)
 					if(flagship && gov == flagship->GetGovernment() &&
 						(eventType & (ShipEvent::PROVOKE | ShipEvent::DISABLE | ShipEvent::DESTROY)))
 					{
-						WitnessResult witnesses = WitnessSystem::CheckWitnesses(
+						WitnessSystem::CheckWitnesses(witnesses,
 							shipHit->Position(), flagship, shipHit.get(), ships);
 
 						// If there are witnesses, queue a report. The report will be
@@ -2573,10 +2629,13 @@ void Engine::DoCollisions(Projectile &projectile)
 								WitnessConstants::REPORT_TRANSMISSION_TIME,
 								player.GetSystem(),
 								0.0);  // Reputation impact calculated later
-							report.activeWitnesses = witnesses.GetSuppressibleWitnesses();
+							for(const shared_ptr<Ship> &witness : witnesses.GetSuppressibleWitnesses())
+								report.activeWitnesses.insert(witness->Handle());
 							report.canBeSuppressed = witnesses.CanSuppressReport();
 							witnessSystem.QueueReport(report);
 						}
+						// Don't keep the witnessing ships alive until the next check.
+						witnesses.Clear();
 					}
 				}
 			}
@@ -2598,7 +2657,7 @@ void Engine::DoCollisions(Projectile &projectile)
 	{
 		for(Ship *ship : hasAntiMissile)
 			if(ship == projectile.Target() || gov->IsEnemy(ship->GetGovernment()))
-				if(ship->FireAntiMissile(projectile, visuals))
+				if(ship->FireAntiMissile(projectile, newVisuals))
 				{
 					projectile.Kill();
 					break;
@@ -2609,8 +2668,8 @@ void Engine::DoCollisions(Projectile &projectile)
 
 
 // Determine whether any active weather events have impacted the ships within
-// the system. As with DoCollisions, this function adds visuals directly to
-// the main visuals list.
+// the system. As with DoCollisions, visuals created here are drawn this step
+// without being moved.
 void Engine::DoWeather(Weather &weather)
 {
 	weather.CalculateStrength();
@@ -2633,7 +2692,7 @@ void Engine::DoWeather(Weather &weather)
 		for(Body *body : affectedShips)
 		{
 			Ship *hit = reinterpret_cast<Ship *>(body);
-			hit->TakeDamage(visuals, damage.CalculateDamage(*hit), nullptr);
+			hit->TakeDamage(newVisuals, damage.CalculateDamage(*hit), nullptr);
 		}
 	}
 }
@@ -2669,7 +2728,7 @@ void Engine::DoCollection(Flotsam &flotsam)
 		int count = 0;
 		for(Ship *ship : hasTractorBeam)
 		{
-			Point shipPull = ship->FireTractorBeam(flotsam, visuals);
+			Point shipPull = ship->FireTractorBeam(flotsam, newVisuals);
 			if(shipPull)
 			{
 				pullVector += shipPull;
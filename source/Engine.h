@@ -29,12 +29,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Information.h"
 #include "MiniMap.h"
 #include "MouseButton.h"
+#include "ParticleSystem.h"
 #include "PlanetLabel.h"
 #include "Point.h"
 #include "Preferences.h"
 #include "Projectile.h"
 #include "Radar.h"
 #include "Rectangle.h"
+#include "SlotMap.h"
 #include "TaskQueue.h"
 #include "WitnessSystem.h"
 
@@ -54,7 +56,6 @@ class Ship;
 class ShipEvent;
 class Sprite;
 class Swizzle;
-class Visual;
 class Weather;
 
 
@@ -187,6 +188,8 @@ private:
 	void CalculateUnpaused(const Ship *flagship, const System *playerSystem);
 
 	void MoveShip(const std::shared_ptr<Ship> &ship);
+	void AddShipSlot(Ship &ship);
+	void RemoveShipSlot(Ship &ship);
 
 	void SpawnFleets();
 	void SpawnPersons();
@@ -221,8 +224,11 @@ private:
 	std::vector<Projectile> projectiles;
 	std::vector<Weather> activeWeather;
 	std::list<std::shared_ptr<Flotsam>> flotsam;
-	std::vector<Visual> visuals;
+	ParticleSystem visuals;
 	AsteroidField asteroids;
+	// Handles for every ship in the list of ships (plus any fighters docked in
+	// them), so that other systems can refer to ships without owning them.
+	SlotMap<Ship *> shipSlots;
 
 	// New objects created within the latest step:
 	std::list<std::shared_ptr<Ship>> newShips;
@@ -292,6 +298,11 @@ private:
 	WitnessSystem witnessSystem;
 
 	CollisionSet shipCollisions;
+	// Scratch lists for DoCollisions(). They are cleared for each projectile
+	// rather than recreated, so that collision checks do not allocate memory.
+	std::vector<Collision> collisions;
+	std::vector<Body *> nearbyBodies;
+	WitnessResult witnesses;
 
 	int alarmTime = 0;
 	double flash = 0.;
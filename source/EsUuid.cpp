@@ -26,6 +26,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <uuid/uuid.h>
 #endif
 
+#include <cstring>
+#include <functional>
 #include <stdexcept>
 
 using namespace std;
@@ -103,6 +105,16 @@ namespace {
 		return uuid_compare(a.id, b.id);
 #endif
 	}
+
+	EsUuid::Key MakeKey(const EsUuid::UuidType &value)
+	{
+		static_assert(sizeof(value.id) == 2 * sizeof(uint64_t), "A UUID must be 128 bits");
+		const auto *bytes = reinterpret_cast<const unsigned char *>(&value.id);
+		EsUuid::Key key;
+		memcpy(&key.high, bytes, sizeof(key.high));
+		memcpy(&key.low, bytes + sizeof(key.high), sizeof(key.low));
+		return key;
+	}
 }
 
 
@@ -132,6 +144,20 @@ EsUuid EsUuid::FromString(const string &input)
 
 
 
+bool EsUuid::ParseKey(const string &input, Key &key)
+{
+	try {
+		key = MakeKey(ParseUuid(input));
+	}
+	catch(const invalid_argument &)
+	{
+		return false;
+	}
+	return true;
+}
+
+
+
 // Explicitly copy the value of the other UUID.
 void EsUuid::Clone(const EsUuid &other)
 {
@@ -168,6 +194,21 @@ string EsUuid::ToString() const noexcept(false)
 
 
 
+EsUuid::Key EsUuid::ToKey() const
+{
+	return MakeKey(Value());
+}
+
+
+
+size_t EsUuid::Key::Hash::operator()(const Key &key) const noexcept
+{
+	// Version 4 UUIDs are random, so either half is already a good hash.
+	return hash<uint64_t>()(key.high ^ key.low);
+}
+
+
+
 // Internal constructor. Note that the provided value may not be a valid v4 UUID,
 // in which case an error is logged and we return a new UUID.
 EsUuid::EsUuid(const string &input)
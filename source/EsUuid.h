@@ -23,6 +23,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <uuid/uuid.h>
 #endif
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 
@@ -47,9 +49,27 @@ public:
 	};
 
 
+	// The value of a UUID packed into two integers, for use as a map key.
+	class Key {
+	public:
+		uint64_t high = 0;
+		uint64_t low = 0;
+
+		bool operator==(const Key &other) const noexcept = default;
+
+		class Hash {
+		public:
+			std::size_t operator()(const Key &key) const noexcept;
+		};
+	};
+
+
 public:
 	static UuidType MakeUuid();
 	static EsUuid FromString(const std::string &input);
+	// Get the key of the UUID written in the given text, without creating an
+	// EsUuid. Returns false if the text is not a valid UUID.
+	static bool ParseKey(const std::string &input, Key &key);
 
 
 public:
@@ -75,6 +95,9 @@ public:
 
 	// Get a string representation of this ID, e.g. for serialization.
 	std::string ToString() const noexcept(false);
+	// Get the value of this ID as a key, which is much cheaper to look up than
+	// its string representation.
+	Key ToKey() const;
 
 
 private:
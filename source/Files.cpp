@@ -453,6 +453,13 @@ void Files::Write(shared_ptr<iostream> file, const string &data)
 
 
 
+void Files::WriteBinary(const filesystem::path &path, const string &data)
+{
+	Write(shared_ptr<iostream>{new fstream{path, ios::out | ios::binary}}, data);
+}
+
+
+
 void Files::CreateFolder(const filesystem::path &path)
 {
 	if(Exists(path))
@@ -69,6 +69,8 @@ public:
 	static std::string Read(std::shared_ptr<std::iostream> file);
 	static void Write(const std::filesystem::path &path, const std::string &data);
 	static void Write(std::shared_ptr<std::iostream> file, const std::string &data);
+	// Write the given data exactly as is, without any translation of line endings.
+	static void WriteBinary(const std::filesystem::path &path, const std::string &data);
 	static void CreateFolder(const std::filesystem::path &path);
 
 	// Open this user's plugins directory in their native file explorer.
@@ -0,0 +1,152 @@
+/* FrameArena.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "FrameArena.h"
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	// Passes requests on to the heap, counting them.
+	class HeapResource : public pmr::memory_resource {
+	public:
+		size_t allocations = 0;
+		size_t bytes = 0;
+
+
+	private:
+		void *do_allocate(size_t size, size_t alignment) override
+		{
+			++allocations;
+			bytes += size;
+			return pmr::new_delete_resource()->allocate(size, alignment);
+		}
+
+		void do_deallocate(void *pointer, size_t size, size_t alignment) override
+		{
+			pmr::new_delete_resource()->deallocate(pointer, size, alignment);
+		}
+
+		bool do_is_equal(const memory_resource &other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	// The arena of one thread, counting the allocations it serves.
+	class ThreadArena : public pmr::memory_resource {
+	public:
+		void Open()
+		{
+			allocations = 0;
+			heap.allocations = 0;
+			heap.bytes = 0;
+			if(buffer.empty())
+				arena.emplace(&heap);
+			else
+				arena.emplace(buffer.data(), buffer.size(), &heap);
+		}
+
+		void Close()
+		{
+			arena.reset();
+			// If this frame needed more than the buffer, grow the buffer so that
+			// the next frame like this one can be served from it entirely.
+			if(heap.bytes)
+				buffer.resize(buffer.size() + heap.bytes);
+		}
+
+
+	public:
+		int depth = 0;
+		size_t allocations = 0;
+		HeapResource heap;
+
+
+	private:
+		void *do_allocate(size_t size, size_t alignment) override
+		{
+			++allocations;
+			return arena->allocate(size, alignment);
+		}
+
+		void do_deallocate(void *, size_t, size_t) override
+		{
+			// Memory is only released when the frame closes.
+		}
+
+		bool do_is_equal(const memory_resource &other) const noexcept override
+		{
+			return this == &other;
+		}
+
+
+	private:
+		// The memory kept from one frame to the next.
+		vector<byte> buffer;
+		optional<pmr::monotonic_buffer_resource> arena;
+	};
+
+	thread_local ThreadArena threadArena;
+
+	atomic<size_t> lastAllocations = 0;
+	atomic<size_t> lastHeapAllocations = 0;
+}
+
+
+
+FrameArena::Frame::Frame()
+{
+	if(!threadArena.depth++)
+		threadArena.Open();
+}
+
+
+
+FrameArena::Frame::~Frame()
+{
+	if(--threadArena.depth)
+		return;
+
+	lastAllocations = threadArena.allocations;
+	lastHeapAllocations = threadArena.heap.allocations;
+	threadArena.Close();
+}
+
+
+
+// Get the memory resource to use for containers that only live for this frame.
+pmr::memory_resource *FrameArena::Resource()
+{
+	return threadArena.depth ? &threadArena : pmr::get_default_resource();
+}
+
+
+
+size_t FrameArena::Allocations()
+{
+	return lastAllocations;
+}
+
+
+
+size_t FrameArena::HeapAllocations()
+{
+	return lastHeapAllocations;
+}
@@ -0,0 +1,53 @@
+/* FrameArena.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+
+
+// Scratch memory for containers that only live for one step of the engine. While
+// a Frame is open on a thread, Resource() hands out memory from a monotonic
+// arena belonging to that thread, and all of it is released at once when the
+// Frame closes. The arena keeps the memory it has needed so far, so once it
+// has grown to the size of a typical step, steps no longer allocate from the
+// heap at all. Outside of a Frame, Resource() falls back to the default memory
+// resource, so code that uses it is also safe to call from other threads.
+// Nothing allocated from Resource() may outlive the Frame it was allocated in.
+class FrameArena {
+public:
+	// Opens a frame on the current thread for as long as it exists. Frames may
+	// be nested; only the outermost one releases the arena.
+	class Frame {
+	public:
+		Frame();
+		~Frame();
+		Frame(const Frame &) = delete;
+		Frame &operator=(const Frame &) = delete;
+	};
+
+
+public:
+	// Get the memory resource to use for containers that only live for this frame.
+	static std::pmr::memory_resource *Resource();
+
+	// The number of allocations served by the arena during the most recently
+	// closed frame on any thread, and how many of them had to go to the heap.
+	static std::size_t Allocations();
+	static std::size_t HeapAllocations();
+};
@@ -62,6 +62,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "StartConditions.h"
 #include "System.h"
 #include "TaskQueue.h"
+#include "TradeNetwork.h"
 #include "test/Test.h"
 #include "test/TestData.h"
 #include "UniverseObjects.h"
@@ -70,6 +71,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <atomic>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -102,11 +104,23 @@ namespace {
 
 	const Government *playerGovernment = nullptr;
 	map<const System *, map<string, int>> purchases;
+	// The trade network, and the universe version it was built for.
+	TradeNetwork tradeNetwork;
+	uint64_t tradeNetworkVersion = UINT64_MAX;
+	// The next day of trade, if it is being calculated in the background.
+	TaskQueue economyQueue;
+	shared_future<void> economyStep;
+	// The next day of trade is started from the calculation thread, but the
+	// main thread may need to cancel it to change the systems or purchases it
+	// reads. This must be held while doing any of those things.
+	mutex economyMutex;
 
 	ConditionsStore globalConditions;
 
 	bool preventSpriteUpload = false;
 
+	uint64_t universeVersion = 0;
+
 	// Tracks the progress of loading the sprites when the game starts.
 	std::atomic<bool> queuedAllImages = false;
 	std::atomic<int> spritesLoaded = 0;
@@ -190,6 +204,28 @@ namespace {
 			LoadSprite(queue, icon);
 		}
 	}
+
+	// Rebuild the trade network if the universe has changed since it was built.
+	void UpdateTradeNetwork(Set<System> &systems)
+	{
+		if(tradeNetworkVersion != universeVersion)
+		{
+			tradeNetwork.Build(systems, GameData::Commodities());
+			tradeNetworkVersion = universeVersion;
+		}
+	}
+
+	// If the next day of trade is being calculated in the background, wait for
+	// it and throw the result away, because the systems are about to change.
+	// The economy mutex must be held until the change is done.
+	void CancelEconomyStep()
+	{
+		if(economyStep.valid())
+		{
+			economyStep.wait();
+			economyStep = shared_future<void>();
+		}
+	}
 }
 
 
@@ -427,6 +463,8 @@ UniverseObjects &GameData::Objects()
 // Revert any changes that have been made to the universe.
 void GameData::Revert()
 {
+	lock_guard<mutex> lock(economyMutex);
+	CancelEconomyStep();
 	objects.fleets.Revert(defaultFleets);
 	objects.governments.Revert(defaultGovernments);
 	objects.planets.Revert(defaultPlanets);
@@ -442,6 +480,7 @@ void GameData::Revert()
 
 	politics.Reset();
 	purchases.clear();
+	++universeVersion;
 }
 
 
@@ -459,6 +498,8 @@ void GameData::ReadEconomy(const DataNode &node)
 {
 	if(!node.Size() || node.Token(0) != "economy")
 		return;
+	lock_guard<mutex> lock(economyMutex);
+	CancelEconomyStep();
 
 	vector<string> headings;
 	for(const DataNode &child : node)
@@ -534,47 +575,47 @@ void GameData::WriteEconomy(DataWriter &out)
 
 
 
+// Start calculating the next day of trade in the background, so that the work
+// is already done when StepEconomy() is called. Nothing that the player can
+// see changes until then.
+void GameData::PrepareEconomy()
+{
+	lock_guard<mutex> lock(economyMutex);
+	if(economyStep.valid())
+		return;
+
+	UpdateTradeNetwork(objects.systems);
+	economyStep = economyQueue.Run([] { tradeNetwork.Step(purchases); });
+}
+
+
+
 void GameData::StepEconomy()
 {
-	// First, apply any purchases the player made. These are deferred until now
-	// so that prices will not change as you are buying or selling goods.
-	for(const auto &pit : purchases)
+	// Any purchases the player made are applied now, rather than when they
+	// were made, so that prices will not change as you are buying or selling
+	// goods. If this day of trade was not already calculated, do it now.
+	lock_guard<mutex> lock(economyMutex);
+	if(economyStep.valid())
 	{
-		System &system = const_cast<System &>(*pit.first);
-		for(const auto &cit : pit.second)
-			system.SetSupply(cit.first, system.Supply(cit.first) - cit.second);
+		economyStep.wait();
+		economyStep = shared_future<void>();
 	}
-	purchases.clear();
-
-	// Then, have each system generate new goods for local use and trade.
-	for(auto &it : objects.systems)
-		it.second.StepEconomy();
-
-	// Finally, send out the trade goods. This has to be done in a separate step
-	// because otherwise whichever systems trade last would already have gotten
-	// supplied by the other systems.
-	for(auto &it : objects.systems)
+	else
 	{
-		System &system = it.second;
-		if(!system.Links().empty())
-			for(const Trade::Commodity &commodity : Commodities())
-			{
-				double supply = system.Supply(commodity.name);
-				for(const System *neighbor : system.Links())
-				{
-					double scale = neighbor->Links().size();
-					if(scale)
-						supply += neighbor->Exports(commodity.name) / scale;
-				}
-				system.SetSupply(commodity.name, supply);
-			}
+		UpdateTradeNetwork(objects.systems);
+		tradeNetwork.Step(purchases);
 	}
+	tradeNetwork.Commit();
+	purchases.clear();
 }
 
 
 
 void GameData::AddPurchase(const System &system, const string &commodity, int tons)
 {
+	lock_guard<mutex> lock(economyMutex);
+	CancelEconomyStep();
 	if(tons < 0)
 		purchases[&system][commodity] += tons;
 }
@@ -584,6 +625,8 @@ void GameData::AddPurchase(const System &system, const string &commodity, int to
 // Apply the given change to the universe.
 void GameData::Change(const DataNode &node, PlayerInfo &player)
 {
+	lock_guard<mutex> lock(economyMutex);
+	CancelEconomyStep();
 	objects.Change(node, player);
 }
 
@@ -593,7 +636,10 @@ void GameData::Change(const DataNode &node, PlayerInfo &player)
 // This must be done any time that a change creates or moves a system.
 void GameData::UpdateSystems()
 {
+	lock_guard<mutex> lock(economyMutex);
+	CancelEconomyStep();
 	objects.UpdateSystems();
+	++universeVersion;
 }
 
 
@@ -601,6 +647,14 @@ void GameData::UpdateSystems()
 void GameData::RecomputeWormholeRequirements()
 {
 	objects.RecomputeWormholeRequirements();
+	++universeVersion;
+}
+
+
+
+uint64_t GameData::UniverseVersion()
+{
+	return universeVersion;
 }
 
 
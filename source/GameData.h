@@ -108,6 +108,9 @@ public:
 	// Functions for the dynamic economy.
 	static void ReadEconomy(const DataNode &node);
 	static void WriteEconomy(DataWriter &out);
+	// Start calculating the next day of trade in the background, e.g. while
+	// the player is in hyperspace. StepEconomy() will then only apply it.
+	static void PrepareEconomy();
 	static void StepEconomy();
 	static void AddPurchase(const System &system, const std::string &commodity, int tons);
 	// Apply the given change to the universe.
@@ -116,6 +119,9 @@ public:
 	// This must be done any time that a change creates or moves a system.
 	static void UpdateSystems();
 	static void RecomputeWormholeRequirements();
+	// A number that changes whenever the map, the links between systems or the
+	// wormhole requirements change, so that cached routes can tell they are stale.
+	static uint64_t UniverseVersion();
 	static void AddJumpRange(double neighborDistance);
 
 	// Re-activate any special persons that were created previously but that are
@@ -301,8 +301,7 @@ void HailPanel::Draw()
 	wrap.SetAlignment(Alignment::JUSTIFIED);
 	wrap.SetWrapWidth(330);
 	wrap.SetFont(FontSet::Get(14));
-	wrap.Wrap(message);
-	wrap.Draw(Point(-50., -50.), *GameData::Colors().Get("medium"));
+	messageLayout.Get(message, wrap).Draw(Point(-50., -50.), *GameData::Colors().Get("medium"));
 
 	++step;
 }
@@ -458,6 +457,7 @@ void HailPanel::SetBribe(double scale)
 void HailPanel::SetMessage(const string &text)
 {
 	message = text;
+	messageLayout.Clear();
 	if(!message.empty())
 		Messages::Add({"(Response to your hail) " + header + " " + message,
 			GameData::MessageCategories().Get("log only")});
@@ -18,6 +18,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Panel.h"
 
 #include "Angle.h"
+#include "text/WrappedTextCache.h"
 
 #include <cstdint>
 #include <memory>
@@ -67,6 +68,8 @@ private:
 
 	std::string header;
 	std::string message;
+	// The message only changes when SetMessage() is called, so it is wrapped once.
+	WrappedTextCache messageLayout;
 
 	int64_t bribe = 0;
 	const Government *bribed = nullptr;
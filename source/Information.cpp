@@ -17,8 +17,77 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "image/Sprite.h"
 
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 using namespace std;
 
+namespace {
+	// Get the slot assigned to the given name, assigning a new one if needed.
+	int Resolve(const string &name)
+	{
+		static unordered_map<string, int> slots;
+		static shared_mutex m;
+
+		// Search using a shared lock, allows parallel access by multiple threads.
+		{
+			shared_lock readLock(m);
+			auto it = slots.find(name);
+			if(it != slots.end())
+				return it->second;
+		}
+
+		// Insert using an exclusive lock, if needed. Blocks all parallel access.
+		unique_lock writeLock(m);
+		return slots.emplace(name, static_cast<int>(slots.size())).first->second;
+	}
+}
+
+
+
+Information::Key::Key(const string &name)
+	: slot(Resolve(name))
+{
+}
+
+
+
+// Get a key for the given condition, which may be negated by prefixing
+// it with one or more "!" characters.
+Information::Key Information::Key::Condition(const string &condition)
+{
+	size_t start = condition.find_first_not_of('!');
+	if(start == string::npos)
+		start = condition.size();
+
+	// An empty condition is always true, so it does not need a slot.
+	Key key;
+	if(start < condition.size())
+		key.slot = Resolve(condition.substr(start));
+	key.isNegated = start % 2;
+	return key;
+}
+
+
+
+bool Information::Key::IsEmpty() const
+{
+	return slot < 0;
+}
+
+
+
+// Remove all the values, but keep the allocated storage.
+void Information::Clear()
+{
+	region = Rectangle();
+	hasCustomRegion = false;
+	positions.assign(positions.size(), 0);
+	values.clear();
+	outlineColor = Color();
+}
+
 
 
 void Information::SetRegion(const Rectangle &rect)
@@ -46,109 +115,205 @@ bool Information::HasCustomRegion() const
 void Information::SetSprite(const string &name, const Sprite *sprite, const Point &unit,
 	float frame, const Swizzle *swizzle)
 {
-	sprites[name] = sprite;
-	spriteUnits[name] = unit;
-	spriteFrames[name] = frame;
-	spriteSwizzles[name] = swizzle;
+	SetSprite(Key(name), sprite, unit, frame, swizzle);
+}
+
+
+
+void Information::SetSprite(const Key &key, const Sprite *sprite, const Point &unit,
+	float frame, const Swizzle *swizzle)
+{
+	if(key.IsEmpty())
+		return;
+
+	Value &value = Insert(key);
+	value.sprite = sprite;
+	value.hasSprite = true;
+	value.unit = unit;
+	value.frame = frame;
+	value.swizzle = swizzle;
 }
 
 
 
 const Sprite *Information::GetSprite(const string &name) const
+{
+	return GetSprite(Key(name));
+}
+
+
+
+const Sprite *Information::GetSprite(const Key &key) const
 {
 	static const Sprite empty;
 
-	auto it = sprites.find(name);
-	return (it == sprites.end()) ? &empty : it->second;
+	const Value *value = Find(key);
+	return (value && value->hasSprite) ? value->sprite : &empty;
 }
 
 
 
 const Point &Information::GetSpriteUnit(const string &name) const
+{
+	return GetSpriteUnit(Key(name));
+}
+
+
+
+const Point &Information::GetSpriteUnit(const Key &key) const
 {
 	static const Point up(0., -1.);
 
-	auto it = spriteUnits.find(name);
-	return (it == spriteUnits.end()) ? up : it->second;
+	const Value *value = Find(key);
+	return value ? value->unit : up;
 }
 
 
 
 float Information::GetSpriteFrame(const string &name) const
 {
-	auto it = spriteFrames.find(name);
-	return (it == spriteFrames.end()) ? 0.f : it->second;
+	return GetSpriteFrame(Key(name));
+}
+
+
+
+float Information::GetSpriteFrame(const Key &key) const
+{
+	const Value *value = Find(key);
+	return value ? value->frame : 0.f;
 }
 
 
 
 const Swizzle *Information::GetSwizzle(const string &name) const
 {
-	auto it = spriteSwizzles.find(name);
-	return it == spriteSwizzles.end() ? 0 : it->second;
+	return GetSwizzle(Key(name));
+}
+
+
+
+const Swizzle *Information::GetSwizzle(const Key &key) const
+{
+	const Value *value = Find(key);
+	return value ? value->swizzle : nullptr;
 }
 
 
 
 void Information::SetString(const string &name, const string &value)
 {
-	strings[name] = value;
+	SetString(Key(name), value);
+}
+
+
+
+void Information::SetString(const Key &key, const string &value)
+{
+	if(key.IsEmpty())
+		return;
+
+	Insert(key).string = value;
 }
 
 
 
 const string &Information::GetString(const string &name) const
+{
+	return GetString(Key(name));
+}
+
+
+
+const string &Information::GetString(const Key &key) const
 {
 	static const string empty;
 
-	auto it = strings.find(name);
-	return (it == strings.end()) ? empty : it->second;
+	const Value *value = Find(key);
+	return value ? value->string : empty;
 }
 
 
 
 void Information::SetBar(const string &name, double value, double segments)
 {
-	bars[name] = value;
-	barSegments[name] = segments;
+	SetBar(Key(name), value, segments);
+}
+
+
+
+void Information::SetBar(const Key &key, double value, double segments)
+{
+	if(key.IsEmpty())
+		return;
+
+	Value &stored = Insert(key);
+	stored.bar = value;
+	stored.barSegments = segments;
 }
 
 
 
 double Information::BarValue(const string &name) const
 {
-	auto it = bars.find(name);
+	return BarValue(Key(name));
+}
+
 
-	return (it == bars.end()) ? 0. : it->second;
+
+double Information::BarValue(const Key &key) const
+{
+	const Value *value = Find(key);
+	return value ? value->bar : 0.;
 }
 
 
 
 double Information::BarSegments(const string &name) const
 {
-	auto it = barSegments.find(name);
+	return BarSegments(Key(name));
+}
 
-	return (it == barSegments.end()) ? 1. : it->second;
+
+
+double Information::BarSegments(const Key &key) const
+{
+	const Value *value = Find(key);
+	return value ? value->barSegments : 1.;
 }
 
 
 
 void Information::SetCondition(const string &condition)
 {
-	conditions.insert(condition);
+	SetCondition(Key(condition));
+}
+
+
+
+void Information::SetCondition(const Key &key)
+{
+	if(key.IsEmpty())
+		return;
+
+	Insert(key).isCondition = true;
 }
 
 
 
 bool Information::HasCondition(const string &condition) const
 {
-	if(condition.empty())
-		return true;
+	return HasCondition(Key::Condition(condition));
+}
+
 
-	if(condition.front() == '!')
-		return !HasCondition(condition.substr(1));
 
-	return conditions.contains(condition);
+bool Information::HasCondition(const Key &key) const
+{
+	if(key.IsEmpty())
+		return !key.isNegated;
+
+	const Value *value = Find(key);
+	return (value && value->isCondition) != key.isNegated;
 }
 
 
@@ -164,3 +329,30 @@ const Color &Information::GetOutlineColor() const
 {
 	return outlineColor;
 }
+
+
+
+// Get the value stored in the given slot, or nullptr if it was never set.
+const Information::Value *Information::Find(const Key &key) const
+{
+	if(key.IsEmpty() || static_cast<size_t>(key.slot) >= positions.size() || !positions[key.slot])
+		return nullptr;
+	return &values[positions[key.slot] - 1];
+}
+
+
+
+// Get the value stored in the given slot, adding it if necessary. The key must
+// not be empty.
+Information::Value &Information::Insert(const Key &key)
+{
+	if(static_cast<size_t>(key.slot) >= positions.size())
+		positions.resize(key.slot + 1, 0);
+	uint32_t &position = positions[key.slot];
+	if(!position)
+	{
+		values.emplace_back();
+		position = static_cast<uint32_t>(values.size());
+	}
+	return values[position - 1];
+}
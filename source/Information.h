@@ -20,56 +20,120 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Rectangle.h"
 #include "Swizzle.h"
 
-#include <map>
-#include <set>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 class Sprite;
 
 
 
 // Class representing information to be displayed in a user interface, independent
-// of how that information is laid out or shown.
+// of how that information is laid out or shown. Values are stored in flat arrays
+// indexed by the slot their name has been assigned, so an interface that has
+// resolved its names to Keys ahead of time can look them up without any string
+// comparisons.
 class Information {
 public:
+	// The name of a value, resolved to its slot. Every distinct name is assigned
+	// a slot the first time a Key is made for it, and keeps it for the rest of
+	// the program. A default-constructed Key refers to nothing.
+	class Key {
+	public:
+		Key() = default;
+		explicit Key(const std::string &name);
+
+		// Get a key for the given condition, which may be negated by prefixing
+		// it with one or more "!" characters. An empty condition is always true.
+		static Key Condition(const std::string &condition);
+
+		bool IsEmpty() const;
+
+
+	private:
+		int slot = -1;
+		bool isNegated = false;
+
+		friend class Information;
+	};
+
+
+public:
+	// Remove all the values, but keep the allocated storage.
+	void Clear();
+
 	void SetRegion(const Rectangle &rect);
 	const Rectangle &GetCustomRegion() const;
 	bool HasCustomRegion() const;
 
 	void SetSprite(const std::string &name, const Sprite *sprite, const Point &unit = Point(0., -1.), float frame = 0.f,
 		const Swizzle *swizzle = Swizzle::None());
+	void SetSprite(const Key &key, const Sprite *sprite, const Point &unit = Point(0., -1.), float frame = 0.f,
+		const Swizzle *swizzle = Swizzle::None());
 	const Sprite *GetSprite(const std::string &name) const;
+	const Sprite *GetSprite(const Key &key) const;
 	const Point &GetSpriteUnit(const std::string &name) const;
+	const Point &GetSpriteUnit(const Key &key) const;
 	float GetSpriteFrame(const std::string &name) const;
+	float GetSpriteFrame(const Key &key) const;
 	const Swizzle *GetSwizzle(const std::string &name) const;
+	const Swizzle *GetSwizzle(const Key &key) const;
 
 	void SetString(const std::string &name, const std::string &value);
+	void SetString(const Key &key, const std::string &value);
 	const std::string &GetString(const std::string &name) const;
+	const std::string &GetString(const Key &key) const;
 
 	void SetBar(const std::string &name, double value, double segments = 0.);
+	void SetBar(const Key &key, double value, double segments = 0.);
 	double BarValue(const std::string &name) const;
+	double BarValue(const Key &key) const;
 	double BarSegments(const std::string &name) const;
+	double BarSegments(const Key &key) const;
 
 	void SetCondition(const std::string &condition);
+	void SetCondition(const Key &key);
 	bool HasCondition(const std::string &condition) const;
+	bool HasCondition(const Key &key) const;
 
 	void SetOutlineColor(const Color &color);
 	const Color &GetOutlineColor() const;
 
 
+private:
+	// Everything that may be stored under one name. Any field that has not
+	// been set holds the value reported for a name that was never set.
+	class Value {
+	public:
+		const Sprite *sprite = nullptr;
+		bool hasSprite = false;
+		Point unit = Point(0., -1.);
+		float frame = 0.f;
+		const Swizzle *swizzle = nullptr;
+		std::string string;
+		double bar = 0.;
+		double barSegments = 1.;
+		bool isCondition = false;
+	};
+
+
+private:
+	// Get the value stored in the given slot, or nullptr if it was never set.
+	const Value *Find(const Key &key) const;
+	// Get the value stored in the given slot, adding it if necessary. The key
+	// must not be empty.
+	Value &Insert(const Key &key);
+
+
 private:
 	Rectangle region;
 	bool hasCustomRegion = false;
 
-	std::map<std::string, const Sprite *> sprites;
-	std::map<std::string, Point> spriteUnits;
-	std::map<std::string, float> spriteFrames;
-	std::map<std::string, const Swizzle *> spriteSwizzles;
-	std::map<std::string, std::string> strings;
-	std::map<std::string, double> bars;
-	std::map<std::string, double> barSegments;
-
-	std::set<std::string> conditions;
+	// For each slot, one more than the index of its value, or zero if nothing
+	// has been stored in that slot. This only grows as large as the highest
+	// slot that has been set, and the values themselves are packed densely.
+	std::vector<uint32_t> positions;
+	std::vector<Value> values;
 
 	Color outlineColor;
 };
@@ -362,8 +362,8 @@ void Interface::Element::Draw(const Information &info, Panel *panel) const
 // An empty string means it is always visible or active.
 void Interface::Element::SetConditions(const string &visible, const string &active)
 {
-	visibleIf = visible;
-	activeIf = active;
+	visibleIf = Information::Key::Condition(visible);
+	activeIf = Information::Key::Condition(active);
 }
 
 
@@ -430,8 +430,8 @@ Interface::ImageElement::ImageElement(const DataNode &node, const Point &globalA
 	// the sprite path will be dynamically supplied by the Information object.
 	if(key == "sprite")
 		sprite[Element::ACTIVE] = SpriteSet::Get(node.Token(1));
-	else
-		name = node.Token(1);
+	else if(!node.Token(1).empty())
+		name = Information::Key(node.Token(1));
 
 	// This function will call ParseLine() for any line it does not recognize.
 	Load(node, globalAnchor);
@@ -456,9 +456,9 @@ bool Interface::ImageElement::ParseLine(const DataNode &node)
 	// The "colored" tag only applies to outlines.
 	const string &key = node.Token(0);
 	bool hasValue = node.Size() >= 2;
-	if(key == "inactive" && hasValue && name.empty())
+	if(key == "inactive" && hasValue && name.IsEmpty())
 		sprite[Element::INACTIVE] = SpriteSet::Get(node.Token(1));
-	else if(key == "hover" && hasValue && name.empty())
+	else if(key == "hover" && hasValue && name.IsEmpty())
 		sprite[Element::HOVER] = SpriteSet::Get(node.Token(1));
 	else if(isOutline && key == "colored")
 		isColored = true;
@@ -516,7 +516,7 @@ void Interface::ImageElement::Draw(const Rectangle &rect, const Information &inf
 
 const Sprite *Interface::ImageElement::GetSprite(const Information &info, int state) const
 {
-	return name.empty() ? sprite[state] : info.GetSprite(name);
+	return name.IsEmpty() ? sprite[state] : info.GetSprite(name);
 }
 
 
@@ -539,6 +539,8 @@ Interface::TextElement::TextElement(const DataNode &node, const Point &globalAnc
 	}
 	else
 		str = node.Token(1);
+	if(isDynamic)
+		stringKey = Information::Key(str);
 }
 
 
@@ -618,9 +620,9 @@ void Interface::TextElement::FinishLoadingColors()
 
 
 // Get text contents of this element.
-string Interface::TextElement::GetString(const Information &info) const
+const string &Interface::TextElement::GetString(const Information &info) const
 {
-	return isDynamic ? info.GetString(str) : str;
+	return isDynamic ? info.GetString(stringKey) : str;
 }
 
 
@@ -674,9 +676,9 @@ Interface::WrappedTextElement::WrappedTextElement(const DataNode &node, const Po
 	FinishLoadingColors();
 
 	// Initialize the WrappedText.
-	text.SetAlignment(textAlignment);
-	text.SetTruncate(truncate);
-	text.SetWrapWidth(Bounds().Width());
+	format.SetAlignment(textAlignment);
+	format.SetTruncate(truncate);
+	format.SetWrapWidth(Bounds().Width());
 }
 
 
@@ -712,8 +714,7 @@ bool Interface::WrappedTextElement::ParseLine(const DataNode &node)
 // Report the actual dimensions of the object that will be drawn.
 Point Interface::WrappedTextElement::NativeDimensions(const Information &info, int state) const
 {
-	text.SetFont(FontSet::Get(fontSize));
-	text.Wrap(GetString(info));
+	const WrappedText &text = Wrap(info);
 	return Point(text.WrapWidth(), text.Height());
 }
 
@@ -722,8 +723,25 @@ Point Interface::WrappedTextElement::NativeDimensions(const Information &info, i
 // Draw this element in the given rectangle.
 void Interface::WrappedTextElement::Draw(const Rectangle &rect, const Information &info, int state) const
 {
-	// The text has already been wrapped in NativeDimensions called by Element::Draw.
-	text.Draw(rect.TopLeft(), *color[state]);
+	Wrap(info).Draw(rect.TopLeft(), *color[state]);
+}
+
+
+
+// Get the current text, wrapped. It is only wrapped again when the text
+// or its formatting changes.
+const WrappedText &Interface::WrappedTextElement::Wrap(const Information &info) const
+{
+	// The fonts may not have been loaded yet when this element was created.
+	format.SetFont(FontSet::Get(fontSize));
+
+	const string &value = GetString(info);
+	if(value != wrappedString)
+	{
+		wrappedString = value;
+		layout.Clear();
+	}
+	return layout.Get(wrappedString, format);
 }
 
 
@@ -737,7 +755,7 @@ Interface::BarElement::BarElement(const DataNode &node, const Point &globalAncho
 		return;
 
 	// Get the name of the element and find out what type it is (bar or ring).
-	name = node.Token(1);
+	name = Information::Key(node.Token(1));
 	isRing = (node.Token(0) == "ring");
 
 	// This function will call ParseLine() for any line it does not recognize.
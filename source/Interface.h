@@ -17,10 +17,12 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "text/Alignment.h"
 #include "Color.h"
+#include "Information.h"
 #include "Point.h"
 #include "Rectangle.h"
 #include "text/Truncate.h"
 #include "text/WrappedText.h"
+#include "text/WrappedTextCache.h"
 
 #include <map>
 #include <memory>
@@ -28,7 +30,6 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <vector>
 
 class DataNode;
-class Information;
 class Panel;
 class Sprite;
 
@@ -117,8 +118,10 @@ private:
 		AnchoredPoint to;
 		Point alignment;
 		Point padding;
-		std::string visibleIf;
-		std::string activeIf;
+		// Conditions are resolved when the interface is loaded, so checking them
+		// while drawing does not involve any string lookups.
+		Information::Key visibleIf;
+		Information::Key activeIf;
 	};
 
 	// This class handles "sprite", "image", and "outline" elements.
@@ -140,7 +143,7 @@ private:
 
 	private:
 		// If a name is given, look up the sprite with that name and draw it.
-		std::string name;
+		Information::Key name;
 		// Otherwise, draw a sprite. Which sprite is drawn depends on the current
 		// state of this element: inactive, active, or hover.
 		const Sprite *sprite[3] = {nullptr, nullptr, nullptr};
@@ -166,11 +169,13 @@ private:
 		// Fill in any undefined state colors.
 		void FinishLoadingColors();
 		// Get text contents of this element.
-		std::string GetString(const Information &info) const;
+		const std::string &GetString(const Information &info) const;
 
 	protected:
 		// The string may either be a name of a dynamic string, or static text.
 		std::string str;
+		// If the string is dynamic, the key its value is stored under.
+		Information::Key stringKey;
 		// Color for inactive, active, and hover states.
 		const Color *color[3] = {nullptr, nullptr, nullptr};
 		int fontSize = 14;
@@ -207,7 +212,14 @@ private:
 		virtual void Draw(const Rectangle &rect, const Information &info, int state) const override;
 
 	private:
-		mutable WrappedText text;
+		// Get the current text, wrapped. It is only wrapped again when the text
+		// or its formatting changes.
+		const WrappedText &Wrap(const Information &info) const;
+
+	private:
+		mutable WrappedText format;
+		mutable WrappedTextCache layout;
+		mutable std::string wrappedString;
 		Alignment textAlignment = Alignment::LEFT;
 	};
 
@@ -224,7 +236,7 @@ private:
 		virtual void Draw(const Rectangle &rect, const Information &info, int state) const override;
 
 	private:
-		std::string name;
+		Information::Key name;
 		const Color *fromColor = nullptr;
 		const Color *toColor = nullptr;
 		float width = 2.f;
@@ -35,6 +35,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "PlayerInfo.h"
 #include "Preferences.h"
 #include "Rectangle.h"
+#include "SaveJournal.h"
+#include "SaveQueue.h"
 #include "shader/StarField.h"
 #include "StartConditionsPanel.h"
 #include "text/Truncate.h"
@@ -44,6 +46,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <cstdlib>
+#include <sstream>
 #include <stdexcept>
 #include <utility>
 
@@ -54,7 +57,8 @@ namespace {
 	string FileDate(const filesystem::path &filename)
 	{
 		string date = "0000-00-00";
-		DataFile file(filename);
+		istringstream header(SavedGame::ReadHeader(filename));
+		DataFile file(header);
 		for(const DataNode &node : file)
 			if(node.Token(0) == "date")
 			{
@@ -480,6 +484,8 @@ bool LoadPanel::Scroll(double dx, double dy)
 
 void LoadPanel::UpdateLists()
 {
+	// List the saves as they will be once any pending writes have finished.
+	SaveQueue::Wait();
 	files.clear();
 
 	vector<filesystem::path> fileList = Files::List(Files::Saves());
@@ -566,7 +572,7 @@ void LoadPanel::SnapshotCallback(const string &name)
 void LoadPanel::WriteSnapshot(const filesystem::path &sourceFile, const filesystem::path &snapshotName)
 {
 	// Copy the autosave to a new, named file.
-	if(Files::Copy(sourceFile, snapshotName))
+	if(SaveJournal::Copy(sourceFile, snapshotName))
 	{
 		UpdateLists();
 		selectedFile = Files::Name(snapshotName);
@@ -614,7 +620,7 @@ void LoadPanel::DeletePilot(const string &)
 	for(const auto &fit : it->second)
 	{
 		filesystem::path path = Files::Saves() / fit.first;
-		Files::Delete(path);
+		SaveJournal::Delete(path);
 		failed |= Files::Exists(path);
 	}
 	if(failed)
@@ -633,7 +639,7 @@ void LoadPanel::DeleteSave()
 	loadedInfo.Clear();
 	string pilot = selectedPilot;
 	filesystem::path path = Files::Saves() / selectedFile;
-	Files::Delete(path);
+	SaveJournal::Delete(path);
 	if(Files::Exists(path))
 		GetUI()->Push(new Dialog("Deleting snapshot file failed."));
 
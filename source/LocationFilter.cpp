@@ -79,32 +79,42 @@ namespace {
 		static mutex distanceMutex;
 		lock_guard<mutex> lock(distanceMutex);
 
-		static const System *previousCenter = center;
-		static DistanceMap distance(
-			center,
-			distanceSettings.WormholeStrat(),
-			distanceSettings.AssumesJumpDrive(),
-			-1,
-			maximum
-		);
-		static int previousMaximum = maximum;
-		static DistanceCalculationSettings previousDistanceSettings = distanceSettings;
-
-		if(center != previousCenter || maximum > previousMaximum || distanceSettings != previousDistanceSettings)
+		// A filter may check distances from both its center and its origin, and
+		// a mission may use several filters, so keep the searches from a few
+		// centers around. Each search answers the checks for every candidate
+		// system within its maximum distance.
+		struct CachedDistance {
+			const System *center;
+			int maximum;
+			DistanceCalculationSettings settings;
+			DistanceMap distance;
+		};
+		static const size_t CACHE_SIZE = 4;
+		static vector<CachedDistance> cache;
+		static uint64_t universeVersion = GameData::UniverseVersion();
+
+		if(universeVersion != GameData::UniverseVersion())
 		{
-			previousCenter = center;
-			previousMaximum = maximum;
-			previousDistanceSettings = distanceSettings;
-			distance = DistanceMap(
-				center,
-				distanceSettings.WormholeStrat(),
-				distanceSettings.AssumesJumpDrive(),
-				-1,
-				maximum
-			);
+			universeVersion = GameData::UniverseVersion();
+			cache.clear();
 		}
+
+		auto it = find_if(cache.begin(), cache.end(), [&](const CachedDistance &entry) {
+			return entry.center == center && entry.maximum >= maximum && !(entry.settings != distanceSettings);
+		});
+		if(it == cache.end())
+		{
+			if(cache.size() == CACHE_SIZE)
+				cache.pop_back();
+			cache.insert(cache.begin(), CachedDistance{center, maximum, distanceSettings,
+				DistanceMap(center, distanceSettings.WormholeStrat(), distanceSettings.AssumesJumpDrive(), -1, maximum)});
+		}
+		// Keep the most recently used searches at the front.
+		else if(it != cache.begin())
+			rotate(cache.begin(), it, it + 1);
+
 		// If the distance is greater than the maximum, this is not a match.
-		int d = distance.Days(*system);
+		int d = cache.front().distance.Days(*system);
 		return (d > maximum) ? -1 : d;
 	}
 
@@ -0,0 +1,112 @@
+/* LruCache.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+
+
+// A map with a fixed number of entries. Once it is full, adding an entry
+// evicts the entry that was used least recently. Lookups, insertions and
+// evictions are all O(1). Each key is stored only once; the index refers to
+// the keys stored in the list of entries, whose nodes never move.
+template<class Key, class Value, class Hash = std::hash<Key>>
+class LruCache {
+public:
+	// A capacity of zero means that entries are never evicted.
+	explicit LruCache(std::size_t capacity) : capacity(capacity) {}
+
+	// Get the value cached for the given key, or nullptr if there is none. A hit
+	// makes the entry the most recently used one.
+	const Value *Get(const Key &key);
+	// Cache a value for the given key, replacing any value it already had.
+	const Value &Set(const Key &key, Value value);
+	// Remove every entry.
+	void Clear() noexcept;
+
+	std::size_t size() const noexcept { return entries.size(); }
+	bool empty() const noexcept { return entries.empty(); }
+
+
+private:
+	using Entry = std::pair<const Key, Value>;
+	using KeyRef = std::reference_wrapper<const Key>;
+
+	class RefHash {
+	public:
+		std::size_t operator()(const KeyRef &key) const { return Hash()(key.get()); }
+	};
+	class RefEqual {
+	public:
+		bool operator()(const KeyRef &a, const KeyRef &b) const { return a.get() == b.get(); }
+	};
+
+
+private:
+	std::size_t capacity;
+	// The entries, from most to least recently used.
+	std::list<Entry> entries;
+	std::unordered_map<KeyRef, typename std::list<Entry>::iterator, RefHash, RefEqual> index;
+};
+
+
+
+template<class Key, class Value, class Hash>
+const Value *LruCache<Key, Value, Hash>::Get(const Key &key)
+{
+	auto it = index.find(std::cref(key));
+	if(it == index.end())
+		return nullptr;
+
+	entries.splice(entries.begin(), entries, it->second);
+	return &it->second->second;
+}
+
+
+
+template<class Key, class Value, class Hash>
+const Value &LruCache<Key, Value, Hash>::Set(const Key &key, Value value)
+{
+	auto it = index.find(std::cref(key));
+	if(it != index.end())
+	{
+		entries.splice(entries.begin(), entries, it->second);
+		it->second->second = std::move(value);
+		return it->second->second;
+	}
+
+	if(capacity && entries.size() >= capacity)
+	{
+		index.erase(std::cref(entries.back().first));
+		entries.pop_back();
+	}
+	entries.emplace_front(key, std::move(value));
+	index.emplace(std::cref(entries.front().first), entries.begin());
+	return entries.front().second;
+}
+
+
+
+template<class Key, class Value, class Hash>
+void LruCache<Key, Value, Hash>::Clear() noexcept
+{
+	index.clear();
+	entries.clear();
+}
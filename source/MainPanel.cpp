@@ -772,10 +772,9 @@ void MainPanel::StepEvents(bool &isActive)
 			{
 				const shared_ptr<Ship> &target = event.Target();
 				string systemName = player.GetSystem() ? player.GetSystem()->TrueName() : "";
-				string uuid = target->UUID().ToString();
 
 				EncounterRecord &record = player.Encounters().GetOrCreate(
-					uuid, player.GetDate(), systemName);
+					target->UUID(), player.GetDate(), systemName);
 
 				record.RecordEncounter(player.GetDate(), systemName);
 				record.RecordEvent(event.Type());
@@ -783,6 +782,7 @@ void MainPanel::StepEvents(bool &isActive)
 				const int combatEvents = ShipEvent::DISABLE | ShipEvent::DESTROY | ShipEvent::PROVOKE;
 				if(event.Type() & combatEvents)
 				{
+					string uuid = target->UUID().ToString();
 					double combatRange = flagship ? flagship->Position().Distance(target->Position()) : 1000.;
 
 					bool playerHasMissiles = false;
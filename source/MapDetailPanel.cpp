@@ -816,7 +816,7 @@ void MapDetailPanel::DrawInfo()
 
 	if(canView)
 	{
-		const SystemEconomy &economy = GameData::GetEconomicManager().GetSystemEconomy(selectedSystem);
+		const SystemEconomy &economy = GameData::GetEconomicManager().ReadSystemEconomy(selectedSystem);
 		EconomicStateType state = economy.GetState();
 		if(state != EconomicStateType::STABLE)
 		{
@@ -0,0 +1,128 @@
+/* MappedFile.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+
+
+bool MappedFile::Open(const filesystem::path &path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(file, &fileSize) || !fileSize.QuadPart)
+	{
+		CloseHandle(file);
+		return false;
+	}
+	// The mapping keeps the file open, so the handle is no longer needed.
+	mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if(!mapping)
+		return false;
+
+	data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if(!data)
+	{
+		CloseHandle(mapping);
+		mapping = nullptr;
+		return false;
+	}
+	size = fileSize.QuadPart;
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if(file < 0)
+		return false;
+
+	struct stat status;
+	if(fstat(file, &status) || !status.st_size)
+	{
+		close(file);
+		return false;
+	}
+	// The mapping keeps the file open, so the descriptor is no longer needed.
+	void *view = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if(view == MAP_FAILED)
+		return false;
+
+	data = static_cast<const char *>(view);
+	size = status.st_size;
+#endif
+	return true;
+}
+
+
+
+void MappedFile::Close()
+{
+	if(!data)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mapping);
+	mapping = nullptr;
+#else
+	munmap(const_cast<char *>(data), size);
+#endif
+	data = nullptr;
+	size = 0;
+}
+
+
+
+bool MappedFile::IsOpen() const
+{
+	return data;
+}
+
+
+
+const char *MappedFile::Data() const
+{
+	return data;
+}
+
+
+
+size_t MappedFile::Size() const
+{
+	return size;
+}
@@ -0,0 +1,50 @@
+/* MappedFile.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+
+
+/// A read-only view of a whole file that is mapped into memory. The operating
+/// system only reads the parts of the file that are actually accessed, and can
+/// drop them from memory again at any time, because they are backed by the file.
+/// Files inside of zip archives cannot be mapped.
+class MappedFile {
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile &other) = delete;
+	MappedFile &operator=(const MappedFile &other) = delete;
+	~MappedFile();
+
+	/// Map the given file, replacing any file that was mapped before.
+	/// Returns false if the file could not be mapped.
+	bool Open(const std::filesystem::path &path);
+	void Close();
+
+	bool IsOpen() const;
+	const char *Data() const;
+	std::size_t Size() const;
+
+
+private:
+	const char *data = nullptr;
+	std::size_t size = 0;
+#ifdef _WIN32
+	void *mapping = nullptr;
+#endif
+};
@@ -85,15 +85,15 @@ void MessageLogPanel::Draw()
 
 		// Draw messages.
 		Point pos = Screen::BottomLeft() + Point(PAD, scroll);
-		for(const auto &[text, category] : messages)
+		for(const Messages::LogEntry &entry : messages)
 		{
-			if(importantOnly && !category->IsImportant())
+			if(importantOnly && !entry.category->IsImportant())
 				continue;
 
-			messageLine.Wrap(text);
-			pos.Y() -= messageLine.Height();
+			const WrappedText &layout = entry.layout.Get(entry.message, messageLine);
+			pos.Y() -= layout.Height();
 			if(pos.Y() >= Screen::Top() - 3 * font.Height())
-				messageLine.Draw(pos, category->LogColor());
+				layout.Draw(pos, entry.category->LogColor());
 		}
 
 		maxScroll = max(0., scroll - pos.Y() + Screen::Top());
@@ -38,7 +38,7 @@ protected:
 
 
 private:
-	const std::deque<std::pair<std::string, const Message::Category *>> &messages;
+	const std::deque<Messages::LogEntry> &messages;
 
 	const double width;
 	bool importantOnly = false;
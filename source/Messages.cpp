@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "GameData.h"
 
 #include <mutex>
+#include <utility>
 
 using namespace std;
 
@@ -29,7 +30,7 @@ namespace {
 
 	vector<pair<string, const Message::Category *>> incoming;
 	vector<Messages::Entry> recent;
-	deque<pair<string, const Message::Category *>> logged;
+	deque<Messages::LogEntry> logged;
 }
 
 
@@ -42,7 +43,7 @@ void Messages::Add(const Message &message)
 		return;
 	string text = message.Text();
 
-	if(category->AllowsLogDuplicates() || logged.empty() || text != logged.front().first)
+	if(category->AllowsLogDuplicates() || logged.empty() || text != logged.front().message)
 	{
 		logged.emplace_front(text, category);
 		if(logged.size() > MAX_LOG)
@@ -109,7 +110,7 @@ const vector<Messages::Entry> &Messages::Get(int step, int animationDuration)
 
 
 
-const deque<pair<string, const Message::Category *>> &Messages::GetLog()
+const deque<Messages::LogEntry> &Messages::GetLog()
 {
 	return logged;
 }
@@ -155,7 +156,7 @@ void Messages::SaveLog(DataWriter &out)
 	out.BeginChild();
 	{
 		for(auto it = logged.rbegin(); it != logged.rend(); ++it)
-			out.Write(it->second->Name(), it->first);
+			out.Write(it->category->Name(), it->message);
 	}
 	out.EndChild();
 }
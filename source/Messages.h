@@ -16,11 +16,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "Message.h"
+#include "text/WrappedTextCache.h"
 
 #include <cstdint>
 #include <deque>
 #include <string>
-#include <utility>
 #include <vector>
 
 class Color;
@@ -45,6 +45,20 @@ public:
 		int deathStep = -1;
 		std::string message;
 		const Message::Category *category;
+		// How this message is wrapped on the HUD, computed when it is first drawn.
+		mutable WrappedTextCache layout;
+	};
+
+	// A message that has been added to the message log.
+	class LogEntry {
+	public:
+		LogEntry(const std::string &message, const Message::Category *category)
+			: message(message), category(category) {}
+
+		std::string message;
+		const Message::Category *category;
+		// How this message is wrapped in the message log, computed when it is first drawn.
+		mutable WrappedTextCache layout;
 	};
 
 
@@ -56,7 +70,7 @@ public:
 	// will be culled out, and new ones that have just been added will have
 	// their "step" set to the given value.
 	static const std::vector<Entry> &Get(int step, int animationDuration);
-	static const std::deque<std::pair<std::string, const Message::Category *>> &GetLog();
+	static const std::deque<LogEntry> &GetLog();
 
 	static void ClearLog();
 	// Reset the messages (i.e. because a new game was loaded).
@@ -0,0 +1,122 @@
+/* ParticleSystem.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ParticleSystem.h"
+
+#include "shader/BatchDrawList.h"
+
+#include <utility>
+
+using namespace std;
+
+
+
+// Take ownership of the given visuals, leaving the given list empty.
+void ParticleSystem::Append(vector<Visual> &added)
+{
+	for(Visual &visual : added)
+	{
+		positions.push_back(visual.position);
+		velocities.push_back(visual.velocity);
+		facings.push_back(visual.angle);
+		spins.push_back(visual.spin);
+		lifetimes.push_back(visual.lifetime);
+		appearances.push_back(std::move(visual));
+	}
+	added.clear();
+}
+
+
+
+// Remove all the visuals, but keep the allocated storage.
+void ParticleSystem::Clear()
+{
+	positions.clear();
+	velocities.clear();
+	facings.clear();
+	spins.clear();
+	lifetimes.clear();
+	appearances.clear();
+}
+
+
+
+// Step every effect forward, removing the ones whose lifetime has run out.
+void ParticleSystem::Move()
+{
+	// Every effect moves, even the ones that are about to expire; they are
+	// removed before they are ever drawn at their new position. Keeping these
+	// loops free of branches lets the compiler vectorize them.
+	const size_t count = positions.size();
+	for(size_t i = 0; i < count; ++i)
+		positions[i] += velocities[i];
+	for(size_t i = 0; i < count; ++i)
+		facings[i] += spins[i];
+	for(size_t i = 0; i < count; ++i)
+		--lifetimes[i];
+
+	for(size_t i = 0; i < lifetimes.size(); )
+	{
+		if(lifetimes[i] < 0)
+			Remove(i);
+		else
+			++i;
+	}
+}
+
+
+
+// Add every effect to the given draw list.
+void ParticleSystem::Draw(BatchDrawList &draw) const
+{
+	for(size_t i = 0; i < positions.size(); ++i)
+		draw.AddVisual(appearances[i], positions[i], facings[i]);
+}
+
+
+
+size_t ParticleSystem::Size() const
+{
+	return positions.size();
+}
+
+
+
+bool ParticleSystem::IsEmpty() const
+{
+	return positions.empty();
+}
+
+
+
+void ParticleSystem::Remove(size_t index)
+{
+	const size_t last = positions.size() - 1;
+	if(index != last)
+	{
+		positions[index] = positions[last];
+		velocities[index] = velocities[last];
+		facings[index] = facings[last];
+		spins[index] = spins[last];
+		lifetimes[index] = lifetimes[last];
+		appearances[index] = std::move(appearances[last]);
+	}
+	positions.pop_back();
+	velocities.pop_back();
+	facings.pop_back();
+	spins.pop_back();
+	lifetimes.pop_back();
+	appearances.pop_back();
+}
@@ -0,0 +1,66 @@
+/* ParticleSystem.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Angle.h"
+#include "Point.h"
+#include "Visual.h"
+
+#include <cstddef>
+#include <vector>
+
+class BatchDrawList;
+
+
+
+// Storage for all the visual effects in flight. Visuals are still created as
+// Visual objects, but once they are handed over to this class, the state that
+// changes every step (position, facing, remaining lifetime) is kept in separate
+// contiguous arrays so that stepping the effects only touches that data. The
+// rest of each Visual (its sprite and animation state) is only read when the
+// effects are drawn. Expired effects are removed by swapping in the last one,
+// so the order of the effects is not preserved.
+class ParticleSystem {
+public:
+	// Take ownership of the given visuals, leaving the given list empty.
+	void Append(std::vector<Visual> &added);
+	// Remove all the visuals, but keep the allocated storage.
+	void Clear();
+
+	// Step every effect forward, removing the ones whose lifetime has run out.
+	void Move();
+	// Add every effect to the given draw list.
+	void Draw(BatchDrawList &draw) const;
+
+	std::size_t Size() const;
+	bool IsEmpty() const;
+
+
+private:
+	void Remove(std::size_t index);
+
+
+private:
+	// Data that is updated every step.
+	std::vector<Point> positions;
+	std::vector<Point> velocities;
+	std::vector<Angle> facings;
+	std::vector<Angle> spins;
+	std::vector<int> lifetimes;
+	// Data that is only needed for drawing. The position and facing stored in
+	// these objects are out of date and must not be used.
+	std::vector<Visual> appearances;
+};
@@ -40,8 +40,11 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "RaidFleet.h"
 #include "Random.h"
 #include "SavedGame.h"
+#include "SaveJournal.h"
+#include "SaveQueue.h"
 #include "Ship.h"
 #include "ShipEvent.h"
+#include "image/Sprite.h"
 #include "StartConditions.h"
 #include "StellarObject.h"
 #include "System.h"
@@ -269,6 +272,9 @@ void PlayerInfo::New(const StartConditions &start)
 // Load player information from a saved game file.
 void PlayerInfo::Load(const filesystem::path &path)
 {
+	// Make sure the file is not still being written.
+	SaveQueue::Wait();
+
 	// Make sure any previously loaded data is cleared.
 	Clear();
 
@@ -294,7 +300,16 @@ void PlayerInfo::Load(const filesystem::path &path)
 	// Register derived conditions now, so old primary versions can load into them.
 	RegisterDerivedConditions();
 
-	DataFile file(path);
+	// If this save has a journal, apply it, and fold it into a new snapshot.
+	DataFile file;
+	if(SaveJournal::HasJournal(path))
+	{
+		istringstream in(SaveJournal::Read(path));
+		file.Load(in);
+		SaveJournal::Compact(path);
+	}
+	else
+		file.Load(path);
 	for(const DataNode &child : file)
 	{
 		const string &key = child.Token(0);
@@ -550,6 +565,7 @@ void PlayerInfo::Load(const filesystem::path &path)
 // Load the most recently saved player (if any). Returns false when no save was loaded.
 bool PlayerInfo::LoadRecent()
 {
+	SaveQueue::Wait();
 	string recentPath = Files::Read(Files::Config() / "recent.txt");
 	// Trim trailing whitespace (including newlines) from the path.
 	while(!recentPath.empty() && recentPath.back() <= ' ')
@@ -574,36 +590,49 @@ void PlayerInfo::Save() const
 	if(!CanBeSaved())
 		return;
 
+	// Compose everything that needs to be saved in memory now; the files are
+	// written in the background, in the order they are queued here.
+	string contents = SaveContents();
+
 	// Remember that this was the most recently saved player.
-	Files::Write(Files::Config() / "recent.txt", filePath + '\n');
+	SaveQueue::Write(Files::Config() / "recent.txt", filePath + '\n');
 
 	if(filePath.rfind(".txt") == filePath.length() - 4)
 	{
-		// Only update the backups if this save will have a newer date.
-		SavedGame saved(filePath);
-		if(saved.GetDate() != date.ToString())
+		// Only update the backups if this save will have a newer date. Whether
+		// it does can only be checked once any earlier save of this file is done.
+		string root = filePath.substr(0, filePath.length() - 4);
+		const string rootPrevious = root + "~~previous-";
+		const int previousCount = Preferences::GetPreviousSaveCount();
+		const bool saveSpaceport = planet->HasServices();
+		SaveQueue::Run([path = filePath, rootPrevious, previousCount, saveSpaceport,
+			contents, today = date.ToString()]
 		{
-			string root = filePath.substr(0, filePath.length() - 4);
-			const int previousCount = Preferences::GetPreviousSaveCount();
-			const string rootPrevious = root + "~~previous-";
+			SavedGame saved(path);
+			if(saved.GetDate() == today)
+				return;
+
 			for(int i = previousCount - 1; i > 0; --i)
 			{
 				const string toMove = rootPrevious + to_string(i) + ".txt";
 				if(Files::Exists(toMove))
 					Files::Move(toMove, rootPrevious + to_string(i + 1) + ".txt");
 			}
-			if(Files::Exists(filePath))
-				Files::Move(filePath, rootPrevious + "1.txt");
-			if(planet->HasServices())
-				Save(rootPrevious + "spaceport.txt");
-		}
+			if(Files::Exists(path))
+				SaveJournal::Move(path, rootPrevious + "1.txt");
+			if(saveSpaceport && DataFile::IsBinary(contents))
+				Files::WriteBinary(rootPrevious + "spaceport.txt", contents);
+			else if(saveSpaceport)
+				Files::Write(rootPrevious + "spaceport.txt", contents);
+		});
 	}
 
-	Save(filePath);
+	SaveJournal::Write(filePath, std::move(contents));
 
 	// Save global conditions:
-	DataWriter globalConditions(Files::Config() / "global conditions.txt");
+	DataWriter globalConditions;
 	GameData::GlobalConditions().Save(globalConditions);
+	SaveQueue::Write(Files::Config() / "global conditions.txt", globalConditions.SaveToString());
 }
 
 
@@ -625,6 +654,8 @@ void PlayerInfo::StartTransaction()
 
 	// Create in-memory DataWriter and save to it.
 	transactionSnapshot = make_unique<DataWriter>();
+	if(Preferences::Has("Compact saved games"))
+		transactionSnapshot->SetBinary();
 	Save(*transactionSnapshot);
 }
 
@@ -4822,21 +4853,39 @@ void PlayerInfo::Autosave() const
 
 
 void PlayerInfo::Save(const string &filePath) const
+{
+	SaveJournal::Write(filePath, SaveContents());
+}
+
+
+
+// Get the text of the saved game. During a transaction, this is the state from
+// when the transaction started.
+string PlayerInfo::SaveContents() const
 {
 	if(transactionSnapshot)
-		transactionSnapshot->SaveToPath(filePath);
-	else
-	{
-		DataWriter out(filePath);
-		Save(out);
-	}
+		return transactionSnapshot->SaveToString();
+
+	DataWriter out;
+	if(Preferences::Has("Compact saved games"))
+		out.SetBinary();
+	Save(out);
+	return out.SaveToString();
 }
 
 
 
 void PlayerInfo::Save(DataWriter &out) const
 {
+	// The save is divided into sections, so that only the sections that have
+	// changed need to be written out again (see SaveJournal).
+	auto section = [&out](const string &name)
+	{
+		out.WriteComment("section: " + name);
+	};
+
 	// Basic player information and persistent UI settings:
+	section("pilot");
 
 	// Pilot information:
 	out.Write("pilot", firstName, lastName);
@@ -4873,6 +4922,20 @@ void PlayerInfo::Save(DataWriter &out) const
 	}
 	else
 		out.Write("flagship index", -1);
+	// Repeat the information that the load panel shows but that would otherwise
+	// only be found far down in the file, so that it only needs to read this far.
+	out.Write("summary");
+	out.BeginChild();
+	{
+		out.Write("credits", accounts.Credits());
+		if(flagship)
+		{
+			out.Write("flagship", flagship->GivenName());
+			if(flagship->HasSprite())
+				out.Write("sprite", flagship->GetSprite()->Name());
+		}
+	}
+	out.EndChild();
 
 	// Save the current setting for the map coloring;
 	out.Write("map coloring", mapColoring);
@@ -4914,6 +4977,7 @@ void PlayerInfo::Save(DataWriter &out) const
 	// Records of things you own:
 	out.Write();
 	out.WriteComment("What you own:");
+	section("ships");
 
 	// Save all the data for all the player's ships.
 	for(const shared_ptr<Ship> &ship : ships)
@@ -4923,6 +4987,7 @@ void PlayerInfo::Save(DataWriter &out) const
 		if(it != groups.end() && it->second)
 			out.Write("groups", it->second);
 	}
+	section("property");
 	if(!planetaryStorage.empty())
 	{
 		out.Write("storage");
@@ -4991,6 +5056,7 @@ void PlayerInfo::Save(DataWriter &out) const
 	// Records of things you have done or are doing, or have happened to you:
 	out.Write();
 	out.WriteComment("What you've done:");
+	section("missions");
 
 	// Save all missions (accepted, accepted-but-invalid, and available).
 	for(const Mission &mission : missions)
@@ -5047,6 +5113,7 @@ void PlayerInfo::Save(DataWriter &out) const
 		out.Write("separate possible");
 
 	// Save any "primary condition" flags that are set.
+	section("conditions");
 	conditions.Save(out);
 
 	// Save the UUID of any ships given to the player with a specified name, and ship class.
@@ -5062,6 +5129,7 @@ void PlayerInfo::Save(DataWriter &out) const
 	}
 
 	// Save pending events, and changes that have happened due to past events.
+	section("events");
 	for(const auto &it : scheduledEvents)
 	{
 		const ExclusiveItem<GameEvent> &event = it.event;
@@ -5088,9 +5156,11 @@ void PlayerInfo::Save(DataWriter &out) const
 		}
 		out.EndChild();
 	}
+	section("economy");
 	GameData::WriteEconomy(out);
 
 	// Check which persons have been captured or destroyed.
+	section("persons");
 	for(const auto &it : GameData::Persons())
 		if(it.second.IsDestroyed())
 			out.Write("destroyed", it.first);
@@ -5099,6 +5169,7 @@ void PlayerInfo::Save(DataWriter &out) const
 	// Records of things you have discovered:
 	out.Write();
 	out.WriteComment("What you know:");
+	section("visited");
 
 	// Save a list of systems the player has visited.
 	WriteSorted(visitedSystems,
@@ -5141,6 +5212,7 @@ void PlayerInfo::Save(DataWriter &out) const
 		out.EndChild();
 	}
 
+	section("logbook");
 	out.Write("logbook");
 	out.BeginChild();
 	{
@@ -5161,12 +5233,16 @@ void PlayerInfo::Save(DataWriter &out) const
 	out.EndChild();
 
 	// Gödel's Sky consequence systems.
+	section("action log");
 	actionLog.Save(out);
+	section("encounter log");
 	encounterLog.Save(out);
+	section("economic state");
 	GameData::GetEconomicManager().Save(out);
 
 	out.Write();
 	out.WriteComment("How you began:");
+	section("start");
 	startData.Save(out);
 
 	// Write plugins to player's save file for debugging.
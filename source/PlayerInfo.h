@@ -426,6 +426,7 @@ private:
 	void Autosave() const;
 	void Save(const std::string &path) const;
 	void Save(DataWriter &out) const;
+	std::string SaveContents() const;
 
 	// Check for and apply any punitive actions from planetary security.
 	void Fine(UI *ui);
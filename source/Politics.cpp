@@ -96,7 +96,7 @@ bool Politics::IsEnemy(const Government *first, const Government *second) const
 			return true;
 
 		auto it = reputationWith.find(second);
-		return (it != reputationWith.end() && it->second < 0.);
+		return (it != reputationWith.end() && reputationManager.CurrentReputation(second, it->second) < 0.);
 	}
 
 	// Neither government is the player, so the question of enemies depends only
@@ -144,7 +144,7 @@ void Politics::Offend(const Government *gov, int eventType, int count)
 			// influencing their reputation with the other.
 			double reputationChange = (count * weight) * penalty.reputationChange;
 			if(penalty.specialPenalty == Government::SpecialPenalty::ATROCITY && weight > 0)
-				Politics::SetReputation(other, min(0., reputationWith[other]));
+				Politics::SetReputation(other, min(0., Reputation(other)));
 
 			Politics::AddReputation(other, -reputationChange);
 		}
@@ -409,20 +409,24 @@ pair<const Conversation *, string> Politics::Fine(PlayerInfo &player,
 double Politics::Reputation(const Government *gov) const
 {
 	auto it = reputationWith.find(gov);
-	return (it == reputationWith.end() ? 0. : it->second);
+	return (it == reputationWith.end() ? 0. : reputationManager.CurrentReputation(gov, it->second));
 }
 
 
 
 void Politics::AddReputation(const Government *gov, double value)
 {
-	SetReputation(gov, reputationWith[gov] + value);
+	SetReputation(gov, Reputation(gov) + value);
 }
 
 
 
 void Politics::SetReputation(const Government *gov, double value)
 {
+	// Commit any decay since the reputation was last changed, so that the new
+	// value starts decaying from today rather than from that earlier date.
+	ApplyDecay(gov);
+
 	value = min(value, gov->ReputationMax());
 	value = max(value, gov->ReputationMin());
 	reputationWith[gov] = value;
@@ -430,6 +434,31 @@ void Politics::SetReputation(const Government *gov, double value)
 
 
 
+void Politics::RecordReputationChange(const Government *gov, const Date &date, double change,
+	const string &reason, bool wasAtrocity, bool wasWitnessed)
+{
+	ApplyDecay(gov);
+	reputationManager.RecordChange(gov, Reputation(gov), date, change, reason, wasAtrocity, wasWitnessed);
+}
+
+
+
+void Politics::RecordGoodDeed(const Government *gov, const Date &date)
+{
+	ApplyDecay(gov);
+	reputationManager.RecordGoodDeed(gov, date);
+}
+
+
+
+void Politics::RecordAtrocity(const Government *gov, const Date &date)
+{
+	ApplyDecay(gov);
+	reputationManager.RecordAtrocity(gov, date);
+}
+
+
+
 // Reset any temporary provocation (typically because a day has passed).
 void Politics::ResetDaily(const Date &date)
 {
@@ -438,9 +467,9 @@ void Politics::ResetDaily(const Date &date)
 	bribedPlanets.clear();
 	fined.clear();
 
-	// Gödel's Sky: Step the reputation decay/recovery system.
+	// Gödel's Sky: Reputation decays lazily toward the current date.
 	if(date)
-		reputationManager.StepDaily(date);
+		reputationManager.SetDate(date);
 }
 
 
@@ -456,3 +485,13 @@ ReputationManager &Politics::GetReputationManager()
 {
 	return reputationManager;
 }
+
+
+
+// Apply any pending decay to the stored reputation with the given government.
+void Politics::ApplyDecay(const Government *gov)
+{
+	auto it = reputationWith.find(gov);
+	if(it != reputationWith.end())
+		reputationManager.ApplyDecay(gov, it->second);
+}
@@ -71,8 +71,16 @@ public:
 	void AddReputation(const Government *gov, double value);
 	void SetReputation(const Government *gov, double value);
 
+	// Record reputation events with the reputation manager. Any decay that is
+	// still pending is applied first, because the event changes how the
+	// reputation decays from then on.
+	void RecordReputationChange(const Government *gov, const Date &date, double change,
+		const std::string &reason = "", bool wasAtrocity = false, bool wasWitnessed = true);
+	void RecordGoodDeed(const Government *gov, const Date &date);
+	void RecordAtrocity(const Government *gov, const Date &date);
+
 	// Reset any temporary effects (typically because a day has passed).
-	// If a date is provided, also steps the reputation decay/recovery system.
+	// If a date is provided, also advances the date that reputation decays toward.
 	void ResetDaily(const Date &date = Date());
 
 	// Gödel's Sky: Access the reputation manager for decay/recovery tracking.
@@ -80,6 +88,11 @@ public:
 	ReputationManager &GetReputationManager();
 
 
+private:
+	// Apply any pending decay to the stored reputation with the given government.
+	void ApplyDecay(const Government *gov);
+
+
 private:
 	// attitude[target][other] stores how much an action toward the given target
 	// government will affect your reputation with the given other government.
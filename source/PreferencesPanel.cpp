@@ -764,6 +764,7 @@ void PreferencesPanel::DrawSettings()
 		"Performance",
 		"Show CPU / GPU load",
 		LARGE_GRAPHICS_REDUCTION,
+		"Software sound mixing",
 		SHIP_OUTLINES,
 		HUD_SHIP_OUTLINES,
 		"",
@@ -818,6 +819,7 @@ void PreferencesPanel::DrawSettings()
 		"Show parenthesis",
 		NOTIFY_ON_DEST,
 		"Save message log",
+		"Compact saved games",
 #ifdef _WIN32
 		"\n",
 		"Windows Options",
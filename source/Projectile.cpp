@@ -62,6 +62,7 @@ Projectile::Projectile(const Ship &parent, Point position, Angle angle, const We
 	cachedTarget = TargetPtr().get();
 	if(cachedTarget)
 	{
+		targetHandle = cachedTarget->Handle();
 		targetGovernment = cachedTarget->GetGovernment();
 		targetDisabled = cachedTarget->IsDisabled();
 	}
@@ -91,6 +92,8 @@ Projectile::Projectile(const Projectile &parent, const Point &offset, const Angl
 	hitsRemaining = weapon->PenetrationCount();
 
 	cachedTarget = TargetPtr().get();
+	if(cachedTarget)
+		targetHandle = parent.targetHandle;
 
 	// Given that submunitions inherit the velocity of the parent projectile,
 	// it is often the case that submunitions don't add any additional velocity.
@@ -120,7 +123,7 @@ Projectile::Projectile(Point position, const Weapon *weapon)
 
 
 // This returns false if it is time to delete this projectile.
-void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
+void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles, const SlotMap<Ship *> &ships)
 {
 	if(--lifetime <= 0)
 	{
@@ -163,7 +166,15 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 	const Ship *target = cachedTarget;
 	if(target)
 	{
-		target = TargetPtr().get();
+		// A target that has a handle is still in flight exactly as long as the
+		// handle is valid. Only targets that never had one need the weak pointer.
+		if(targetHandle.IsNull())
+			target = TargetPtr().get();
+		else
+		{
+			Ship *const *inFlight = ships.Get(targetHandle);
+			target = inFlight ? *inFlight : nullptr;
+		}
 		if(!target || !target->IsTargetable() || target->GetGovernment() != targetGovernment ||
 				(!targetDisabled && !FighterHitHelper::IsValidTarget(target)))
 		{
@@ -221,7 +232,10 @@ void Projectile::Move(vector<Visual> &visuals, vector<Projectile> &projectiles)
 		// The very dumbest of homing missiles lose their target if pointed
 		// away from it.
 		if(isFacingAway && weapon->HasBlindspot())
+		{
 			targetShip.reset();
+			targetHandle = SlotHandle();
+		}
 		else
 		{
 			double desiredTurn = TO_DEG * asin(cross);
@@ -380,6 +394,7 @@ void Projectile::BreakTarget()
 {
 	targetShip.reset();
 	cachedTarget = nullptr;
+	targetHandle = SlotHandle();
 	targetGovernment = nullptr;
 	targetDisabled = false;
 }
@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Angle.h"
 #include "Point.h"
+#include "SlotMap.h"
 
 #include <cstdint>
 #include <memory>
@@ -65,8 +66,9 @@ public:
 	// Point Unit() const;
 	// const Government *GetGovernment() const;
 
-	// Move the projectile. It may create effects or submunitions.
-	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &projectiles);
+	// Move the projectile. It may create effects or submunitions. The given
+	// slot map is used to look up the target while it is in flight.
+	void Move(std::vector<Visual> &visuals, std::vector<Projectile> &projectiles, const SlotMap<Ship *> &ships);
 	// This projectile hit something. Create the explosion, if any. This also
 	// marks the projectile as needing deletion if it has run out of penetrations.
 	void Explode(std::vector<Visual> &visuals, double intersection, Point hitVelocity = Point());
@@ -120,6 +122,9 @@ private:
 
 	std::weak_ptr<Ship> targetShip;
 	const Ship *cachedTarget = nullptr;
+	// The handle of the target at the time it was acquired. While it stays
+	// valid, the target can be checked without locking the weak pointer.
+	SlotHandle targetHandle;
 	bool targetDisabled = false;
 	const Government *targetGovernment = nullptr;
 
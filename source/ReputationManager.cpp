@@ -21,6 +21,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Government.h"
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
 
 using namespace std;
@@ -63,6 +64,72 @@ ReputationEvent::ReputationEvent(const Date &date, double change, const string &
 
 
 
+void ReputationEventHistory::push_back(const ReputationEvent &event)
+{
+	if(events.size() < CAPACITY)
+	{
+		events.push_back(event);
+		return;
+	}
+	events[start] = event;
+	start = (start + 1) % CAPACITY;
+}
+
+
+
+void ReputationEventHistory::clear()
+{
+	events.clear();
+	start = 0;
+}
+
+
+
+void ReputationEventHistory::Trim(size_t maxEvents)
+{
+	if(events.size() <= maxEvents)
+		return;
+
+	// Unroll the buffer so that the events to keep are at the end of it.
+	rotate(events.begin(), events.begin() + start, events.end());
+	events.erase(events.begin(), events.end() - maxEvents);
+	start = 0;
+}
+
+
+
+size_t ReputationEventHistory::size() const
+{
+	return events.size();
+}
+
+
+
+bool ReputationEventHistory::empty() const
+{
+	return events.empty();
+}
+
+
+
+const ReputationEvent &ReputationEventHistory::operator[](size_t index) const
+{
+	return events[(start + index) % events.size()];
+}
+
+
+
+vector<ReputationEvent> ReputationEventHistory::ToVector() const
+{
+	vector<ReputationEvent> result;
+	result.reserve(events.size());
+	result.insert(result.end(), events.begin() + start, events.end());
+	result.insert(result.end(), events.begin(), events.begin() + start);
+	return result;
+}
+
+
+
 ThresholdCrossing::ThresholdCrossing(const Government *gov, ReputationThreshold from,
 	ReputationThreshold to, const Date &date, double oldRep, double newRep)
 	: government(gov), fromThreshold(from), toThreshold(to), date(date),
@@ -92,6 +159,8 @@ void GovernmentReputationState::Load(const DataNode &node)
 			troughReputation = child.Value(1);
 		else if(key == "days since positive" && child.Size() >= 2)
 			daysSincePositiveInteraction = child.Value(1);
+		else if(key == "last decay" && child.Size() >= 4)
+			lastDecay = Date(child.Value(1), child.Value(2), child.Value(3));
 		else if(key == "event")
 		{
 			ReputationEvent event;
@@ -139,9 +208,12 @@ void GovernmentReputationState::Save(DataWriter &out) const
 			out.Write("trough reputation", troughReputation);
 		if(daysSincePositiveInteraction > 0)
 			out.Write("days since positive", daysSincePositiveInteraction);
+		if(lastDecay)
+			out.Write("last decay", lastDecay.Day(), lastDecay.Month(), lastDecay.Year());
 
-		for(const ReputationEvent &event : recentEvents)
+		for(size_t i = 0; i < recentEvents.size(); ++i)
 		{
+			const ReputationEvent &event = recentEvents[i];
 			out.Write("event");
 			out.BeginChild();
 			{
@@ -180,11 +252,7 @@ void GovernmentReputationState::RecordEvent(const ReputationEvent &event)
 
 void GovernmentReputationState::TrimEventHistory(int maxEvents)
 {
-	if(recentEvents.size() > static_cast<size_t>(maxEvents))
-	{
-		recentEvents.erase(recentEvents.begin(),
-			recentEvents.begin() + (recentEvents.size() - maxEvents));
-	}
+	recentEvents.Trim(max(0, maxEvents));
 }
 
 
@@ -215,6 +283,7 @@ void ReputationManager::Load(const DataNode &node)
 			}
 		}
 	}
+	StartDecay();
 }
 
 
@@ -267,64 +336,92 @@ const ReputationConfig &ReputationManager::GetConfig(const Government *gov) cons
 
 
 
-vector<ThresholdCrossing> ReputationManager::StepDaily(const Date &currentDate)
+void ReputationManager::SetDate(const Date &currentDate)
 {
-	vector<ThresholdCrossing> crossings;
+	today = currentDate;
+	StartDecay();
+}
 
-	// Process each government the player has interacted with.
-	for(auto &pair : states)
-	{
-		const Government *gov = pair.first;
-		if(!gov)
-			continue;
 
-		GovernmentReputationState &state = pair.second;
 
-		// Increment days since positive interaction.
-		++state.daysSincePositiveInteraction;
+double ReputationManager::CurrentReputation(const Government *gov, double reputation) const
+{
+	auto it = states.find(gov);
+	if(it == states.end() || !today)
+		return reputation;
 
-		// Get current reputation.
-		double currentRep = gov->Reputation();
-		double oldRep = currentRep;
+	const GovernmentReputationState &state = it->second;
+	if(!state.lastDecay || state.lastDecay >= today)
+		return reputation;
+	if(state.projectedDate != today || state.projectedFrom != reputation)
+	{
+		state.projectedDate = today;
+		state.projectedFrom = reputation;
+		state.projectedTo = Project(GetConfig(gov), state, reputation, today - state.lastDecay);
+	}
+	return state.projectedTo;
+}
 
-		// Apply decay/recovery.
-		double newRep = ApplyDecay(gov, currentRep, currentDate);
 
-		// Check for threshold crossing.
-		ReputationThreshold from, to;
-		if(CrossesThreshold(oldRep, newRep, from, to))
-		{
-			crossings.emplace_back(gov, from, to, currentDate, oldRep, newRep);
-		}
 
-		// Apply the change through the government's reputation setter.
-		if(newRep != oldRep)
-			gov->SetReputation(newRep);
+vector<ThresholdCrossing> ReputationManager::Update(const Government *gov, double &reputation)
+{
+	vector<ThresholdCrossing> crossings;
 
-		// Check for atrocity forgiveness.
-		if(state.hasCommittedAtrocity)
+	int days = 0;
+	GovernmentReputationState *pending = PendingDecay(gov, days);
+	if(!pending)
+		return crossings;
+	GovernmentReputationState &state = *pending;
+
+	const ReputationConfig &config = GetConfig(gov);
+	const double newRep = Project(config, state, reputation, days);
+
+	// Reputation only ever moves toward the neutral point, so each threshold is
+	// crossed at most once, and the day it was crossed on can be found by a
+	// binary search over the days in this interval.
+	int day = 0;
+	double current = reputation;
+	while(GetThreshold(current) != GetThreshold(newRep))
+	{
+		const ReputationThreshold from = GetThreshold(current);
+		int low = day;
+		int high = days;
+		while(high - low > 1)
 		{
-			const ReputationConfig &config = GetConfig(gov);
-			if(config.forgivesAtrocities && state.atrocityDate)
-			{
-				int daysSinceAtrocity = currentDate - state.atrocityDate;
-				if(daysSinceAtrocity >= config.atrocityForgivenessDays)
-				{
-					state.hasCommittedAtrocity = false;
-				}
-			}
+			int mid = low + (high - low) / 2;
+			if(GetThreshold(Project(config, state, reputation, mid)) == from)
+				low = mid;
+			else
+				high = mid;
 		}
-
-		// Trim event history.
-		state.TrimEventHistory(MAX_EVENT_HISTORY);
+		const double before = Project(config, state, reputation, high - 1);
+		const double after = Project(config, state, reputation, high);
+		crossings.emplace_back(gov, from, GetThreshold(after), state.lastDecay + high, before, after);
+		day = high;
+		current = after;
 	}
 
+	Commit(config, state, reputation, newRep, days);
 	return crossings;
 }
 
 
 
-void ReputationManager::RecordChange(const Government *gov, const Date &date,
+void ReputationManager::ApplyDecay(const Government *gov, double &reputation)
+{
+	int days = 0;
+	GovernmentReputationState *state = PendingDecay(gov, days);
+	if(!state)
+		return;
+
+	const ReputationConfig &config = GetConfig(gov);
+	Commit(config, *state, reputation, Project(config, *state, reputation, days), days);
+}
+
+
+
+void ReputationManager::RecordChange(const Government *gov, double reputation, const Date &date,
 	double change, const string &reason, bool wasAtrocity, bool wasWitnessed)
 {
 	if(!gov)
@@ -334,11 +431,10 @@ void ReputationManager::RecordChange(const Government *gov, const Date &date,
 	state.RecordEvent(ReputationEvent(date, change, reason, wasAtrocity, wasWitnessed));
 
 	// Update peak/trough tracking.
-	double currentRep = gov->Reputation();
-	if(currentRep > state.peakReputation)
-		state.peakReputation = currentRep;
-	if(currentRep < state.troughReputation)
-		state.troughReputation = currentRep;
+	if(reputation > state.peakReputation)
+		state.peakReputation = reputation;
+	if(reputation < state.troughReputation)
+		state.troughReputation = reputation;
 }
 
 
@@ -394,7 +490,10 @@ const GovernmentReputationState *ReputationManager::GetState(const Government *g
 
 GovernmentReputationState &ReputationManager::GetOrCreateState(const Government *gov)
 {
-	return states[gov];
+	auto result = states.try_emplace(gov);
+	if(result.second)
+		result.first->second.lastDecay = today;
+	return result.first->second;
 }
 
 
@@ -402,32 +501,13 @@ GovernmentReputationState &ReputationManager::GetOrCreateState(const Government
 double ReputationManager::GetEffectiveDecayRate(const Government *gov) const
 {
 	const ReputationConfig &config = GetConfig(gov);
-	double rate = config.positiveDecayRate;
-
 	auto it = states.find(gov);
-	if(it != states.end())
-	{
-		const GovernmentReputationState &state = it->second;
-
-		// Memory strength reduces decay.
-		rate *= (1.0 - config.memoryStrength);
-
-		// Good deeds slow decay.
-		if(state.goodDeedCount > 0)
-		{
-			double reduction = min(0.5, state.goodDeedCount * 0.05);
-			rate *= (1.0 - reduction);
-		}
-
-		// Recent positive interaction slows decay.
-		if(state.daysSincePositiveInteraction < 7)
-		{
-			double reduction = 0.3 * (1.0 - state.daysSincePositiveInteraction / 7.0);
-			rate *= (1.0 - reduction);
-		}
-	}
+	if(it == states.end())
+		return max(0.0, config.positiveDecayRate);
 
-	return max(0.0, rate);
+	const GovernmentReputationState &state = it->second;
+	int pending = (today && state.lastDecay) ? max(0, today - state.lastDecay) : 0;
+	return DecayRate(config, state, state.daysSincePositiveInteraction + pending);
 }
 
 
@@ -435,26 +515,13 @@ double ReputationManager::GetEffectiveDecayRate(const Government *gov) const
 double ReputationManager::GetEffectiveRecoveryRate(const Government *gov) const
 {
 	const ReputationConfig &config = GetConfig(gov);
-	double rate = config.negativeRecoveryRate;
-
 	auto it = states.find(gov);
-	if(it != states.end())
-	{
-		const GovernmentReputationState &state = it->second;
-
-		// Atrocities significantly slow recovery.
-		if(state.hasCommittedAtrocity)
-			rate *= 0.1;
-
-		// Long time since last interaction helps recovery.
-		if(state.daysSincePositiveInteraction > 30)
-		{
-			double bonus = min(0.5, (state.daysSincePositiveInteraction - 30) * 0.01);
-			rate *= (1.0 + bonus);
-		}
-	}
+	if(it == states.end())
+		return max(0.0, config.negativeRecoveryRate);
 
-	return max(0.0, rate);
+	const GovernmentReputationState &state = it->second;
+	int pending = (today && state.lastDecay) ? max(0, today - state.lastDecay) : 0;
+	return RecoveryRate(config, state.daysSincePositiveInteraction + pending, state.hasCommittedAtrocity);
 }
 
 
@@ -522,7 +589,7 @@ vector<ReputationEvent> ReputationManager::GetRecentEvents(const Government *gov
 
 	// Note: Without a reference date, we return all stored events.
 	// In practice, the caller should filter by date if needed.
-	return it->second.recentEvents;
+	return it->second.recentEvents.ToVector();
 }
 
 
@@ -538,32 +605,140 @@ vector<const Government *> ReputationManager::GetKnownGovernments() const
 
 
 
-double ReputationManager::ApplyDecay(const Government *gov, double currentRep,
-	const Date &currentDate)
+// Governments that have no decay date yet start decaying from today, so that
+// reading and updating their reputation agree on how much decay is pending.
+void ReputationManager::StartDecay()
 {
-	const ReputationConfig &config = GetConfig(gov);
-	double neutralPoint = config.neutralPoint;
+	if(!today)
+		return;
+	for(auto &it : states)
+		if(!it.second.lastDecay)
+			it.second.lastDecay = today;
+}
+
+
+
+GovernmentReputationState *ReputationManager::PendingDecay(const Government *gov, int &days)
+{
+	auto it = states.find(gov);
+	if(it == states.end() || !today)
+		return nullptr;
+
+	GovernmentReputationState &state = it->second;
+	if(!state.lastDecay)
+		state.lastDecay = today;
+	days = today - state.lastDecay;
+	return days > 0 ? &state : nullptr;
+}
+
 
-	if(currentRep > neutralPoint)
+
+void ReputationManager::Commit(const ReputationConfig &config, GovernmentReputationState &state,
+	double &reputation, double newRep, int days)
+{
+	reputation = newRep;
+	state.daysSincePositiveInteraction += days;
+	if(state.hasCommittedAtrocity && config.forgivesAtrocities && state.atrocityDate
+			&& today - state.atrocityDate >= config.atrocityForgivenessDays)
+		state.hasCommittedAtrocity = false;
+	state.lastDecay = today;
+}
+
+
+
+double ReputationManager::Project(const ReputationConfig &config, const GovernmentReputationState &state,
+	double reputation, int days) const
+{
+	// The first day on which a forgiven atrocity no longer slows recovery. It
+	// is forgiven at the end of the day its forgiveness period runs out.
+	int forgivenDay = INT_MAX;
+	if(state.hasCommittedAtrocity && config.forgivesAtrocities && state.atrocityDate)
+		forgivenDay = max(2, config.atrocityForgivenessDays - (state.lastDecay - state.atrocityDate) + 1);
+
+	// Each day, the distance from the neutral point shrinks by that day's rate.
+	// The rates only change over the first few days after an interaction, so
+	// those days are applied one at a time and every run of days with the same
+	// rate after them is applied at once.
+	double offset = reputation - config.neutralPoint;
+	int day = 1;
+	while(day <= days && offset)
 	{
-		// Positive reputation decays toward neutral.
-		double rate = GetEffectiveDecayRate(gov);
-		double decay = (currentRep - neutralPoint) * rate;
-		double newRep = currentRep - decay;
+		const int sincePositive = state.daysSincePositiveInteraction + day;
+		int run = days - day + 1;
+		double rate = 0.;
+		if(offset > 0.)
+		{
+			rate = DecayRate(config, state, sincePositive);
+			if(sincePositive < 7)
+				run = 1;
+		}
+		else
+		{
+			const bool atrocity = state.hasCommittedAtrocity && day < forgivenDay;
+			rate = RecoveryRate(config, sincePositive, atrocity);
+			if(sincePositive <= 30)
+				run = min(run, 31 - sincePositive);
+			else if(sincePositive < 80)
+				run = 1;
+			if(atrocity)
+				run = min(run, forgivenDay - day);
+		}
 
-		// Don't decay below neutral point.
-		return max(neutralPoint, newRep);
+		// Reputation never decays or recovers past the neutral point.
+		const double factor = 1. - rate;
+		if(factor <= 0.)
+			offset = 0.;
+		else
+			offset *= (run == 1) ? factor : pow(factor, run);
+		day += run;
 	}
-	else if(currentRep < neutralPoint)
+
+	return config.neutralPoint + offset;
+}
+
+
+
+double ReputationManager::DecayRate(const ReputationConfig &config, const GovernmentReputationState &state,
+	int days)
+{
+	double rate = config.positiveDecayRate;
+
+	// Memory strength reduces decay.
+	rate *= (1.0 - config.memoryStrength);
+
+	// Good deeds slow decay.
+	if(state.goodDeedCount > 0)
 	{
-		// Negative reputation recovers toward neutral.
-		double rate = GetEffectiveRecoveryRate(gov);
-		double recovery = (neutralPoint - currentRep) * rate;
-		double newRep = currentRep + recovery;
+		double reduction = min(0.5, state.goodDeedCount * 0.05);
+		rate *= (1.0 - reduction);
+	}
 
-		// Don't recover above neutral point.
-		return min(neutralPoint, newRep);
+	// Recent positive interaction slows decay.
+	if(days < 7)
+	{
+		double reduction = 0.3 * (1.0 - days / 7.0);
+		rate *= (1.0 - reduction);
 	}
 
-	return currentRep;
+	return max(0.0, rate);
+}
+
+
+
+double ReputationManager::RecoveryRate(const ReputationConfig &config, int days, bool hasCommittedAtrocity)
+{
+	double rate = config.negativeRecoveryRate;
+
+	// Atrocities significantly slow recovery.
+	if(hasCommittedAtrocity)
+		rate *= 0.1;
+
+	// Long time since last interaction helps recovery.
+	if(days > 30)
+	{
+		double bonus = min(0.5, (days - 30) * 0.01);
+		rate *= (1.0 + bonus);
+	}
+
+	return max(0.0, rate);
 }
@@ -17,6 +17,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "Date.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <set>
@@ -92,6 +93,35 @@ struct ReputationEvent {
 
 
 
+// The most recent reputation events for one government, oldest first. Once the
+// history is full, each new event overwrites the oldest one in place.
+class ReputationEventHistory {
+public:
+	static constexpr std::size_t CAPACITY = 50;
+
+
+public:
+	void push_back(const ReputationEvent &event);
+	void clear();
+	// Drop the oldest events until no more than the given number remain.
+	void Trim(std::size_t maxEvents);
+
+	std::size_t size() const;
+	bool empty() const;
+	// Get the event at the given position, counting from the oldest.
+	const ReputationEvent &operator[](std::size_t index) const;
+
+	std::vector<ReputationEvent> ToVector() const;
+
+
+private:
+	std::vector<ReputationEvent> events;
+	// The position of the oldest event in the storage.
+	std::size_t start = 0;
+};
+
+
+
 // Tracks when the player crossed important reputation thresholds.
 struct ThresholdCrossing {
 	const Government *government = nullptr;
@@ -123,7 +153,7 @@ struct GovernmentReputationState {
 	int goodDeedCount = 0;
 
 	// Recent reputation changes for history.
-	std::vector<ReputationEvent> recentEvents;
+	ReputationEventHistory recentEvents;
 
 	// Highest reputation ever achieved (for decay calculations).
 	double peakReputation = 0.0;
@@ -131,9 +161,18 @@ struct GovernmentReputationState {
 	// Lowest reputation ever reached.
 	double troughReputation = 0.0;
 
-	// Days since last positive interaction.
+	// Days since last positive interaction, as of the last decay date.
 	int daysSincePositiveInteraction = 0;
 
+	// The date through which decay has been applied to the stored reputation.
+	Date lastDecay;
+
+	// The last decay projected for a read, so that reading the reputation
+	// again on the same day does not repeat the calculation.
+	mutable Date projectedDate;
+	mutable double projectedFrom = 0.;
+	mutable double projectedTo = 0.;
+
 	// Load/save state.
 	void Load(const DataNode &node);
 	void Save(DataWriter &out) const;
@@ -150,6 +189,10 @@ struct GovernmentReputationState {
 // Manager class for enhanced reputation mechanics.
 // This works alongside the existing Politics class to add decay, memory,
 // and more sophisticated reputation tracking.
+// Decay is not applied day by day. Instead, each government remembers the date
+// through which its reputation has decayed, and the decay for any number of
+// days since then is calculated in closed form when the reputation is read,
+// and committed when it is next changed.
 class ReputationManager {
 public:
 	// Default configuration values.
@@ -174,12 +217,28 @@ public:
 	// Get the configuration for a government (uses defaults if not set).
 	const ReputationConfig &GetConfig(const Government *gov) const;
 
-	// Called once per day to apply reputation decay/recovery.
-	// Returns any threshold crossings that occurred.
-	std::vector<ThresholdCrossing> StepDaily(const Date &currentDate);
-
-	// Record a reputation change for tracking purposes.
-	void RecordChange(const Government *gov, const Date &date, double change,
+	// Set the current date. Reputation decays toward this date the next time it
+	// is read, however many days have passed.
+	void SetDate(const Date &currentDate);
+
+	// Get the given stored reputation with a government, including any decay or
+	// recovery that has not been applied to it yet.
+	double CurrentReputation(const Government *gov, double reputation) const;
+	// Apply any pending decay or recovery to the given stored reputation.
+	// Returns any threshold crossings that occurred, each dated to the exact
+	// day on which the threshold was crossed.
+	std::vector<ThresholdCrossing> Update(const Government *gov, double &reputation);
+	// Apply any pending decay or recovery to the given stored reputation,
+	// without looking for the thresholds it crossed.
+	void ApplyDecay(const Government *gov, double &reputation);
+
+	// Recording an event changes how the reputation decays from then on, so
+	// any decay that is still pending must be applied to the stored reputation
+	// (e.g. with ApplyDecay()) before any of these are called.
+
+	// Record a reputation change for tracking purposes. The given reputation
+	// is the one after the change.
+	void RecordChange(const Government *gov, double reputation, const Date &date, double change,
 		const std::string &reason = "", bool wasAtrocity = false, bool wasWitnessed = true);
 
 	// Record a good deed (slows decay).
@@ -220,9 +279,29 @@ public:
 
 
 private:
-	// Apply decay to a single government.
-	// Returns the new reputation value.
-	double ApplyDecay(const Government *gov, double currentRep, const Date &currentDate);
+	// Governments that have no decay date yet start decaying from today.
+	void StartDecay();
+	// Get the state of the given government if it has any decay pending, and
+	// the number of days that is pending for.
+	GovernmentReputationState *PendingDecay(const Government *gov, int &days);
+
+	// Commit the decay of the given number of days, which took the stored
+	// reputation to the given value.
+	void Commit(const ReputationConfig &config, GovernmentReputationState &state,
+		double &reputation, double newRep, int days);
+
+	// Calculate the reputation after the given number of days of decay or
+	// recovery, starting from the state's last decay date.
+	double Project(const ReputationConfig &config, const GovernmentReputationState &state,
+		double reputation, int days) const;
+
+	// The daily rates for the given number of days since the last positive
+	// interaction.
+	static double DecayRate(const ReputationConfig &config, const GovernmentReputationState &state, int days);
+	static double RecoveryRate(const ReputationConfig &config, int days, bool hasCommittedAtrocity);
+
+	// The current date, toward which each government's reputation decays.
+	Date today;
 
 	// Default configuration for governments without specific settings.
 	ReputationConfig defaultConfig;
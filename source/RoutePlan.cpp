@@ -46,16 +46,18 @@ RoutePlan::RoutePlan(const RoutePlan &other)
 
 void RoutePlan::Init(const DistanceMap &distance)
 {
-	auto it = distance.route.find(distance.destination);
-	if(it == distance.route.end())
+	const System *system = distance.destination;
+	const RouteEdge *edge = system ? distance.Find(*system) : nullptr;
+	if(!edge)
 		return;
 
 	hasRoute = true;
 
-	while(it->first != distance.center)
+	while(system != distance.center)
 	{
-		plan.emplace_back(it->first, it->second);
-		it = distance.route.find(it->second.prev);
+		plan.emplace_back(system, *edge);
+		system = edge->prev;
+		edge = distance.Find(*system);
 	}
 }
 
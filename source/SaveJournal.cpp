@@ -0,0 +1,394 @@
+/* SaveJournal.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "SaveJournal.h"
+
+#include "Files.h"
+#include "SaveQueue.h"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	const string SECTION = "# section: ";
+	const string SNAPSHOT = "# snapshot ";
+	const string JOURNAL = "# journal ";
+	const string RECORD = "# record";
+	const string END = "# end record";
+
+	// Fold the journal into a new snapshot once it has this many records.
+	const int MAX_RECORDS = 32;
+
+	// The name and contents of each section of a saved game, in order.
+	using Sections = vector<pair<string, string>>;
+
+	// What is on disk for a file that has been saved with a journal.
+	class State {
+	public:
+		string id;
+		Sections sections;
+		uintmax_t snapshotSize = 0;
+		uintmax_t journalSize = 0;
+		int records = 0;
+	};
+	map<filesystem::path, State> states;
+	mutex statesMutex;
+
+
+	filesystem::path JournalPath(const filesystem::path &path)
+	{
+		filesystem::path journal = path;
+		journal += ".journal";
+		return journal;
+	}
+
+
+	// Get the size of the given file, or 0 if it does not exist.
+	uintmax_t FileSize(const filesystem::path &path)
+	{
+		error_code error;
+		uintmax_t size = filesystem::file_size(path, error);
+		return error ? 0 : size;
+	}
+
+
+	// Each snapshot gets a new ID, so that a journal can never be applied to
+	// any snapshot other than the one it was written for.
+	string NewId()
+	{
+		static int count = 0;
+		return to_string(chrono::system_clock::now().time_since_epoch().count()) + "-" + to_string(++count);
+	}
+
+
+	// Call the given function for each line of the text, without its line ending.
+	template<class F>
+	void ForEachLine(const string &text, F function)
+	{
+		size_t start = 0;
+		while(start < text.size())
+		{
+			size_t end = text.find('\n', start);
+			if(end == string::npos)
+				end = text.size();
+			size_t length = end - start;
+			if(length && text[start + length - 1] == '\r')
+				--length;
+			function(string_view(text).substr(start, length));
+			start = end + 1;
+		}
+	}
+
+
+	// Split a saved game into its sections. If it has a snapshot ID, store it in
+	// the given string. Returns no sections if the text is not divided into them.
+	Sections Split(const string &text, string *id)
+	{
+		Sections sections;
+		bool unsectioned = false;
+		ForEachLine(text, [&](string_view line)
+		{
+			if(line.starts_with(SECTION))
+				sections.emplace_back(line.substr(SECTION.size()), "");
+			else if(!sections.empty())
+			{
+				sections.back().second += line;
+				sections.back().second += '\n';
+			}
+			else if(id && line.starts_with(SNAPSHOT))
+				*id = line.substr(SNAPSHOT.size());
+			else if(!line.empty())
+				unsectioned = true;
+		});
+		if(unsectioned)
+			sections.clear();
+		return sections;
+	}
+
+
+	string Join(const Sections &sections)
+	{
+		string text;
+		for(const auto &[name, contents] : sections)
+		{
+			text += SECTION;
+			text += name;
+			text += '\n';
+			text += contents;
+		}
+		return text;
+	}
+
+
+	bool SameLayout(const Sections &a, const Sections &b)
+	{
+		if(a.size() != b.size())
+			return false;
+		for(size_t i = 0; i < a.size(); ++i)
+			if(a[i].first != b[i].first)
+				return false;
+		return true;
+	}
+
+
+	// Write the given sections as a new snapshot, replacing any journal. This
+	// must be called with the states mutex held.
+	void WriteSnapshot(const filesystem::path &path, Sections sections)
+	{
+		string id = NewId();
+		if(!SaveQueue::WriteNow(path, SNAPSHOT + id + '\n' + Join(sections)))
+		{
+			// The old snapshot and its journal are still intact, but no longer
+			// match what this file is expected to contain.
+			states.erase(path);
+			return;
+		}
+
+		filesystem::path journal = JournalPath(path);
+		if(Files::Exists(journal))
+			Files::Delete(journal);
+
+		State &state = states[path];
+		state.id = std::move(id);
+		state.sections = std::move(sections);
+		state.snapshotSize = FileSize(path);
+		state.journalSize = 0;
+		state.records = 0;
+	}
+
+
+	// Save the given contents, appending only what changed to the journal if
+	// possible. This must be called with the states mutex held.
+	void Save(const filesystem::path &path, const string &contents)
+	{
+		Sections sections = Split(contents, nullptr);
+		// Saves that are not divided into sections can only be written in full.
+		if(sections.empty())
+		{
+			states.erase(path);
+			if(SaveQueue::WriteNow(path, contents))
+			{
+				filesystem::path journal = JournalPath(path);
+				if(Files::Exists(journal))
+					Files::Delete(journal);
+			}
+			return;
+		}
+
+		// A journal can only be added to if the files on disk are still exactly
+		// as they were left by the last save.
+		auto it = states.find(path);
+		filesystem::path journal = JournalPath(path);
+		if(it == states.end() || it->second.records >= MAX_RECORDS
+				|| !SameLayout(it->second.sections, sections)
+				|| FileSize(path) != it->second.snapshotSize
+				|| FileSize(journal) != it->second.journalSize)
+		{
+			WriteSnapshot(path, std::move(sections));
+			return;
+		}
+		State &state = it->second;
+
+		string record;
+		for(size_t i = 0; i < sections.size(); ++i)
+			if(sections[i].second != state.sections[i].second)
+			{
+				record += SECTION;
+				record += sections[i].first;
+				record += '\n';
+				record += sections[i].second;
+			}
+		if(record.empty())
+			return;
+
+		// Once the journal would be bigger than the snapshot, it is no longer
+		// cheaper than just writing a new snapshot.
+		if(state.journalSize + record.size() > state.snapshotSize)
+		{
+			WriteSnapshot(path, std::move(sections));
+			return;
+		}
+
+		bool written = false;
+		{
+			ofstream out(journal, ios::out | ios::app | ios::binary);
+			if(!state.journalSize)
+				out << JOURNAL << state.id << '\n';
+			out << RECORD << '\n' << record << END << '\n';
+			out.flush();
+			written = out.good();
+		}
+		// If the record could not be added, the journal may now end in an
+		// incomplete record. Those are ignored when reading, but start over
+		// with a new snapshot anyway.
+		if(!written)
+		{
+			WriteSnapshot(path, std::move(sections));
+			return;
+		}
+
+		state.sections = std::move(sections);
+		state.journalSize = FileSize(journal);
+		++state.records;
+
+		// The load panel orders saves by when their snapshot was last modified.
+		error_code error;
+		filesystem::last_write_time(path, filesystem::file_time_type::clock::now(), error);
+	}
+}
+
+
+
+// Queue the given contents to be saved to the given file.
+void SaveJournal::Write(const filesystem::path &path, string contents)
+{
+	SaveQueue::Run([path, contents = std::move(contents)]
+	{
+		lock_guard<mutex> lock(statesMutex);
+		Save(path, contents);
+	});
+}
+
+
+
+// Queue folding the journal of the given file, if any, into its snapshot.
+void SaveJournal::Compact(const filesystem::path &path)
+{
+	SaveQueue::Run([path]
+	{
+		if(!HasJournal(path))
+			return;
+
+		Sections sections = Split(Read(path), nullptr);
+		if(sections.empty())
+			return;
+
+		lock_guard<mutex> lock(statesMutex);
+		WriteSnapshot(path, std::move(sections));
+	});
+}
+
+
+
+// Read a saved game, with all the changes in its journal applied.
+string SaveJournal::Read(const filesystem::path &path)
+{
+	string contents = Files::Read(path);
+	if(!HasJournal(path))
+		return contents;
+
+	string id;
+	Sections sections = Split(contents, &id);
+	if(sections.empty() || id.empty())
+		return contents;
+
+	// A journal that was written for a different snapshot, for example because
+	// the game was interrupted while replacing it, is ignored.
+	string journal = Files::Read(JournalPath(path));
+	if(!journal.starts_with(JOURNAL + id + '\n') && !journal.starts_with(JOURNAL + id + "\r\n"))
+		return contents;
+
+	// Apply each complete record in turn. A record that was cut off at the end
+	// of the journal never finished being written, so it is left out.
+	Sections record;
+	bool inRecord = false;
+	ForEachLine(journal, [&](string_view line)
+	{
+		if(line == RECORD)
+		{
+			record.clear();
+			inRecord = true;
+		}
+		else if(!inRecord)
+			return;
+		else if(line == END)
+		{
+			for(auto &[name, body] : record)
+				for(auto &section : sections)
+					if(section.first == name)
+						section.second = std::move(body);
+			inRecord = false;
+		}
+		else if(line.starts_with(SECTION))
+			record.emplace_back(line.substr(SECTION.size()), "");
+		else if(!record.empty())
+		{
+			record.back().second += line;
+			record.back().second += '\n';
+		}
+	});
+
+	return Join(sections);
+}
+
+
+
+bool SaveJournal::HasJournal(const filesystem::path &path)
+{
+	return Files::Exists(JournalPath(path));
+}
+
+
+
+// Copy a saved game along with its journal, as a single snapshot.
+bool SaveJournal::Copy(const filesystem::path &from, const filesystem::path &to)
+{
+	Delete(to);
+	if(!HasJournal(from))
+		return Files::Copy(from, to);
+	return SaveQueue::WriteNow(to, Read(from));
+}
+
+
+
+// Move a saved game along with its journal, as a single snapshot.
+void SaveJournal::Move(const filesystem::path &from, const filesystem::path &to)
+{
+	{
+		lock_guard<mutex> lock(statesMutex);
+		states.erase(from);
+	}
+	Delete(to);
+	if(!HasJournal(from))
+	{
+		Files::Move(from, to);
+		return;
+	}
+	if(SaveQueue::WriteNow(to, Read(from)))
+		Delete(from);
+}
+
+
+
+void SaveJournal::Delete(const filesystem::path &path)
+{
+	{
+		lock_guard<mutex> lock(statesMutex);
+		states.erase(path);
+	}
+	Files::Delete(path);
+	filesystem::path journal = JournalPath(path);
+	if(Files::Exists(journal))
+		Files::Delete(journal);
+}
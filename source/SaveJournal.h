@@ -0,0 +1,48 @@
+/* SaveJournal.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+
+
+// Rather than rewriting a whole saved game every time the game is saved, it can
+// be kept as a full snapshot plus a journal of what changed since then. The
+// contents of a save are divided into sections, each starting with a
+// "# section: <name>" comment. Each save appends only the sections that differ
+// from what is already on disk to the journal, as a single record. After a
+// number of records, and whenever the game is loaded, the journal is folded
+// back into a new snapshot. Saves without sections, such as binary ones, are
+// always written in full. The journal of "<file>" is "<file>.journal".
+class SaveJournal {
+public:
+	// Queue the given contents to be saved to the given file.
+	static void Write(const std::filesystem::path &path, std::string contents);
+	// Queue folding the journal of the given file, if any, into its snapshot.
+	static void Compact(const std::filesystem::path &path);
+
+	// Read a saved game, with all the changes in its journal applied.
+	static std::string Read(const std::filesystem::path &path);
+	static bool HasJournal(const std::filesystem::path &path);
+
+	// Copy, move or delete a saved game along with its journal. The copy or
+	// moved file is always a single, complete snapshot.
+	static bool Copy(const std::filesystem::path &from, const std::filesystem::path &to);
+	static void Move(const std::filesystem::path &from, const std::filesystem::path &to);
+	static void Delete(const std::filesystem::path &path);
+};
@@ -0,0 +1,144 @@
+/* SaveQueue.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SaveQueue.h"
+
+#include "DataFile.h"
+#include "Files.h"
+#include "Logger.h"
+#include "TaskQueue.h"
+
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+using namespace std;
+
+namespace {
+	// Operations that have been queued but not started yet.
+	deque<function<void()>> pending;
+	// Whether a drain task has been handed to the task queue and has not yet
+	// found the pending list empty. At most one drain task exists at a time, so
+	// the operations are carried out in order and only one of the shared worker
+	// threads is ever busy saving.
+	bool drainScheduled = false;
+	mutex pendingMutex;
+
+	TaskQueue &Queue()
+	{
+		static TaskQueue queue;
+		return queue;
+	}
+
+	// Carry out queued operations until there are none left.
+	void Drain()
+	{
+		while(true)
+		{
+			function<void()> operation;
+			{
+				lock_guard<mutex> lock(pendingMutex);
+				if(pending.empty())
+				{
+					drainScheduled = false;
+					return;
+				}
+				operation = std::move(pending.front());
+				pending.pop_front();
+			}
+
+			try {
+				operation();
+			}
+			catch(const exception &error)
+			{
+				Logger::Log("Error while saving: " + string(error.what()), Logger::Level::ERROR);
+			}
+		}
+	}
+}
+
+
+
+// Queue the given contents to be written to the given file.
+void SaveQueue::Write(const filesystem::path &path, string data)
+{
+	Run([path, data = std::move(data)]
+	{
+		WriteNow(path, data);
+	});
+}
+
+
+
+// Queue any other file operation, to be run after all the previously queued ones.
+void SaveQueue::Run(function<void()> operation)
+{
+	lock_guard<mutex> lock(pendingMutex);
+	pending.push_back(std::move(operation));
+	// If a drain task is already running or waiting to run, it will pick this
+	// operation up before it finishes.
+	if(!drainScheduled)
+	{
+		drainScheduled = true;
+		Queue().Run(Drain);
+	}
+}
+
+
+
+// Write the given contents to the given file right away, only replacing the
+// file if the new contents were written in full.
+bool SaveQueue::WriteNow(const filesystem::path &path, const string &data)
+{
+	filesystem::path temporary = path;
+	temporary += ".tmp";
+	// Don't let a temporary file left over from an earlier, interrupted save
+	// take the place of this one.
+	if(Files::Exists(temporary))
+		Files::Delete(temporary);
+
+	bool written = false;
+	{
+		shared_ptr<iostream> file = DataFile::IsBinary(data)
+			? shared_ptr<iostream>{new fstream{temporary, ios::out | ios::binary}}
+			: Files::Open(temporary, true);
+		Files::Write(file, data);
+		written = file && file->good();
+	}
+
+	// Only replace the existing file once its replacement is known to be
+	// complete. Otherwise, keep the old one.
+	if(!written)
+	{
+		if(Files::Exists(temporary))
+			Files::Delete(temporary);
+		Logger::Log("Unable to write \"" + path.string() + "\".", Logger::Level::ERROR);
+		return false;
+	}
+	Files::Move(temporary, path);
+	return true;
+}
+
+
+
+// Block until every queued operation has finished.
+void SaveQueue::Wait()
+{
+	Queue().Wait();
+}
@@ -0,0 +1,46 @@
+/* SaveQueue.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+
+
+
+// Writing a large saved game to disk can take long enough to cause a visible
+// hitch, so the contents of a save are composed in memory on the main thread
+// and then handed to this class to be written in the background. All queued
+// operations are carried out one at a time in the order they were queued, so
+// e.g. rotating the previous saves and then writing the new one is safe. Each
+// file is first written under a temporary name and then renamed into place, so
+// an interrupted write never leaves a truncated save behind.
+class SaveQueue {
+public:
+	// Queue the given contents to be written to the given file.
+	static void Write(const std::filesystem::path &path, std::string data);
+	// Queue any other file operation, to be run after all the previously queued ones.
+	static void Run(std::function<void()> operation);
+	// Write the given contents to the given file right away, only replacing the
+	// file if the new contents were written in full. Returns false if the write
+	// failed. Unlike Write(), this is not queued, so it happens right away even
+	// if earlier operations are still pending.
+	static bool WriteNow(const std::filesystem::path &path, const std::string &data);
+
+	// Block until every queued operation has finished. This must be called
+	// before reading any file that may have a pending write, and before quitting.
+	static void Wait();
+};
@@ -18,12 +18,16 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "DataFile.h"
 #include "DataNode.h"
 #include "Date.h"
+#include "Files.h"
 #include "text/Format.h"
 #include "GameData.h"
 #include "Planet.h"
+#include "SaveJournal.h"
 #include "image/SpriteSet.h"
 #include "System.h"
 
+#include <sstream>
+
 using namespace std;
 
 
@@ -35,10 +39,52 @@ SavedGame::SavedGame(const filesystem::path &path)
 
 
 
+// Read the start of a saved game file, up to the end of its summary. For
+// older saves that have no summary, this is the entire file.
+string SavedGame::ReadHeader(const filesystem::path &path)
+{
+	// The changes in a journal could be to any part of the file.
+	if(SaveJournal::HasJournal(path))
+		return SaveJournal::Read(path);
+
+	shared_ptr<iostream> in = Files::Open(path);
+	if(!in)
+		return "";
+
+	// The binary encoding is not line based, so it must be read in full.
+	string signature(DataFile::BINARY_SIGNATURE.size(), '\0');
+	in->read(signature.data(), signature.size());
+	if(DataFile::IsBinary(signature))
+		return signature + Files::Read(in);
+	in->clear();
+	in->seekg(0);
+
+	string header;
+	string line;
+	bool inSummary = false;
+	while(getline(*in, line))
+	{
+		// Any line that is not indented starts a new top-level node. Once the
+		// node after the summary begins, everything that is needed has been read.
+		if(!line.empty() && line[0] > ' ' && line[0] != '#')
+		{
+			if(inSummary)
+				break;
+			inSummary = !line.compare(0, 7, "summary") && (line.size() == 7 || line[7] <= ' ');
+		}
+		header += line;
+		header += '\n';
+	}
+	return header;
+}
+
+
+
 void SavedGame::Load(const filesystem::path &path)
 {
 	Clear();
-	DataFile file(path);
+	istringstream header(ReadHeader(path));
+	DataFile file(header);
 	if(file.begin() != file.end())
 		this->path = path;
 
@@ -71,6 +117,20 @@ void SavedGame::Load(const filesystem::path &path)
 			playTime = Format::PlayTime(node.Value(1));
 		else if(key == "flagship index" && hasValue)
 			flagshipTarget = node.Value(1);
+		else if(key == "summary")
+		{
+			for(const DataNode &child : node)
+			{
+				const string &childKey = child.Token(0);
+				bool childHasValue = child.Size() >= 2;
+				if(childKey == "credits" && childHasValue)
+					credits = Format::Credits(child.Value(1));
+				else if(childKey == "flagship" && childHasValue)
+					shipName = child.Token(1);
+				else if(childKey == "sprite" && childHasValue)
+					shipSprite = SpriteSet::Get(child.Token(1));
+			}
+		}
 		else if(key == "account")
 		{
 			for(const DataNode &child : node)
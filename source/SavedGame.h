@@ -32,6 +32,10 @@ public:
 	SavedGame() = default;
 	explicit SavedGame(const std::filesystem::path &path);
 
+	// Read the start of a saved game file, up to the end of its summary. For
+	// older saves that have no summary, this is the entire file.
+	static std::string ReadHeader(const std::filesystem::path &path);
+
 	void Load(const std::filesystem::path &path);
 	const std::filesystem::path &Path() const;
 	bool IsLoaded() const;
@@ -1199,6 +1199,20 @@ void Ship::SetUUID(const EsUuid &id)
 
 
 
+const SlotHandle &Ship::Handle() const noexcept
+{
+	return handle;
+}
+
+
+
+void Ship::SetHandle(const SlotHandle &handle) noexcept
+{
+	this->handle = handle;
+}
+
+
+
 const string &Ship::GivenName() const
 {
 	return givenName;
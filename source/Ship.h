@@ -30,6 +30,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Port.h"
 #include "ship/ShipAICache.h"
 #include "ShipJumpNavigation.h"
+#include "SlotMap.h"
 
 #include <array>
 #include <list>
@@ -165,6 +166,9 @@ public:
 	const EsUuid &UUID() const noexcept;
 	// Explicitly set this ship's ID.
 	void SetUUID(const EsUuid &id);
+	// The handle the engine refers to this ship by while it is in flight.
+	const SlotHandle &Handle() const noexcept;
+	void SetHandle(const SlotHandle &handle) noexcept;
 
 	// Get the name of this particular ship.
 	const std::string &GivenName() const;
@@ -619,6 +623,7 @@ private:
 	const Sprite *thumbnail = nullptr;
 	// Characteristics of this particular ship:
 	EsUuid uuid;
+	SlotHandle handle;
 	std::string givenName;
 	bool canBeCarried = false;
 
@@ -0,0 +1,222 @@
+/* SlotMap.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+
+// A stable reference to an object stored in a SlotMap. A handle stays unique
+// even after the object it refers to has been erased, because every reuse of a
+// slot increments that slot's generation. A default-constructed handle never
+// refers to anything.
+class SlotHandle {
+public:
+	constexpr SlotHandle() noexcept = default;
+	constexpr SlotHandle(uint32_t index, uint32_t generation) noexcept : index(index), generation(generation) {}
+
+	constexpr uint32_t Index() const noexcept { return index; }
+	constexpr uint32_t Generation() const noexcept { return generation; }
+	// Generation zero is reserved for handles that were never assigned.
+	constexpr bool IsNull() const noexcept { return !generation; }
+	// Pack the handle into a single value, e.g. for hashing.
+	constexpr uint64_t Value() const noexcept { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+	constexpr bool operator==(const SlotHandle &other) const noexcept = default;
+	constexpr bool operator<(const SlotHandle &other) const noexcept { return Value() < other.Value(); }
+
+	class Hash {
+	public:
+		std::size_t operator()(const SlotHandle &handle) const noexcept { return std::hash<uint64_t>()(handle.Value()); }
+	};
+
+
+private:
+	uint32_t index = 0;
+	uint32_t generation = 0;
+};
+
+
+
+// A generational slot map: objects are stored contiguously so that iterating
+// over them is cache-friendly, while handles to them remain valid no matter how
+// the storage is rearranged. Insertion, erasure and handle lookups are all O(1).
+// Erasing an object moves the last object into its place, so the iteration order
+// is not stable across erasures.
+template<class Type>
+class SlotMap {
+	using iterator = typename std::vector<Type>::iterator;
+	using const_iterator = typename std::vector<Type>::const_iterator;
+public:
+	// Add an object to the map, returning the handle that refers to it.
+	SlotHandle Insert(Type value);
+	// Remove the object the given handle refers to. Returns false if the
+	// handle was not valid.
+	bool Erase(const SlotHandle &handle);
+	// Remove every object, invalidating all handles that have been given out.
+	void Clear() noexcept;
+
+	// Check whether the given handle still refers to an object in this map.
+	bool Contains(const SlotHandle &handle) const noexcept;
+	// Get the object a handle refers to, or nullptr if the handle is stale.
+	Type *Get(const SlotHandle &handle) noexcept;
+	const Type *Get(const SlotHandle &handle) const noexcept;
+
+	// Get the handle of the object at the given position in the dense storage.
+	SlotHandle HandleAt(std::size_t position) const noexcept;
+
+	std::size_t size() const noexcept { return objects.size(); }
+	bool empty() const noexcept { return objects.empty(); }
+	void reserve(std::size_t n) { objects.reserve(n); owners.reserve(n); slots.reserve(n); }
+
+	iterator begin() noexcept { return objects.begin(); }
+	const_iterator begin() const noexcept { return objects.begin(); }
+	iterator end() noexcept { return objects.end(); }
+	const_iterator end() const noexcept { return objects.end(); }
+
+
+private:
+	class Slot {
+	public:
+		// Position of this slot's object in the dense storage, or the next free
+		// slot if this slot is not in use.
+		uint32_t position = 0;
+		// Odd generations are in use, even generations are free. This makes
+		// zero (the null handle) a free generation for every slot.
+		uint32_t generation = 0;
+	};
+
+	static constexpr uint32_t NO_FREE_SLOT = UINT32_MAX;
+
+
+private:
+	// Densely packed objects, and the slot each of them belongs to.
+	std::vector<Type> objects;
+	std::vector<uint32_t> owners;
+	// The indirection table that handles point into.
+	std::vector<Slot> slots;
+	uint32_t firstFree = NO_FREE_SLOT;
+};
+
+
+
+template<class Type>
+SlotHandle SlotMap<Type>::Insert(Type value)
+{
+	uint32_t index = firstFree;
+	if(index == NO_FREE_SLOT)
+	{
+		index = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+	else
+		firstFree = slots[index].position;
+
+	Slot &slot = slots[index];
+	slot.position = static_cast<uint32_t>(objects.size());
+	++slot.generation;
+	objects.emplace_back(std::move(value));
+	owners.push_back(index);
+
+	return SlotHandle(index, slot.generation);
+}
+
+
+
+template<class Type>
+bool SlotMap<Type>::Erase(const SlotHandle &handle)
+{
+	if(!Contains(handle))
+		return false;
+
+	Slot &slot = slots[handle.Index()];
+	uint32_t position = slot.position;
+	uint32_t last = static_cast<uint32_t>(objects.size() - 1);
+	if(position != last)
+	{
+		objects[position] = std::move(objects[last]);
+		owners[position] = owners[last];
+		slots[owners[position]].position = position;
+	}
+	objects.pop_back();
+	owners.pop_back();
+
+	// Retire this generation and put the slot on the free list.
+	++slot.generation;
+	slot.position = firstFree;
+	firstFree = handle.Index();
+	return true;
+}
+
+
+
+template<class Type>
+void SlotMap<Type>::Clear() noexcept
+{
+	// Retire the generation of every slot that is in use.
+	for(uint32_t index : owners)
+		++slots[index].generation;
+	// Every slot is free now. Rebuild the free list from the highest slot down,
+	// so that the slots are reused in ascending order.
+	firstFree = NO_FREE_SLOT;
+	for(uint32_t index = static_cast<uint32_t>(slots.size()); index-- > 0; )
+	{
+		slots[index].position = firstFree;
+		firstFree = index;
+	}
+	objects.clear();
+	owners.clear();
+}
+
+
+
+template<class Type>
+bool SlotMap<Type>::Contains(const SlotHandle &handle) const noexcept
+{
+	return !handle.IsNull() && handle.Index() < slots.size()
+		&& slots[handle.Index()].generation == handle.Generation();
+}
+
+
+
+template<class Type>
+Type *SlotMap<Type>::Get(const SlotHandle &handle) noexcept
+{
+	return Contains(handle) ? &objects[slots[handle.Index()].position] : nullptr;
+}
+
+
+
+template<class Type>
+const Type *SlotMap<Type>::Get(const SlotHandle &handle) const noexcept
+{
+	return Contains(handle) ? &objects[slots[handle.Index()].position] : nullptr;
+}
+
+
+
+template<class Type>
+SlotHandle SlotMap<Type>::HandleAt(std::size_t position) const noexcept
+{
+	if(position >= owners.size())
+		return SlotHandle();
+	uint32_t index = owners[position];
+	return SlotHandle(index, slots[index].generation);
+}
@@ -27,9 +27,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Planet.h"
 #include "Random.h"
 #include "image/SpriteSet.h"
+#include "SystemGrid.h"
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
 
 using namespace std;
 
@@ -42,6 +47,27 @@ namespace {
 	const double VOLUME = 2000.;
 	// Above this supply amount, price differences taper off:
 	const double LIMIT = 20000.;
+
+	// The numbers that identify systems.
+	class IndexPool {
+	public:
+		// The numbers of systems that have been destroyed. These are given out
+		// again, lowest first, before any new numbers, so that the numbers in
+		// use stay densely packed.
+		priority_queue<uint32_t, vector<uint32_t>, greater<uint32_t>> free;
+		// The next new number to give out, which is also one more than the
+		// highest number that has ever been in use.
+		uint32_t next = 0;
+		mutex lock;
+	};
+
+	// Systems may be created and destroyed during static initialization and
+	// destruction, so the pool is created on first use and never destroyed.
+	IndexPool &Indices()
+	{
+		static IndexPool *pool = new IndexPool;
+		return *pool;
+	}
 }
 
 const double System::DEFAULT_NEIGHBOR_DISTANCE = 100.;
@@ -519,7 +545,7 @@ void System::Load(const DataNode &node, Set<Planet> &planets, const ConditionsSt
 // Update any information about the system that may have changed due to events,
 // or because the game was started, e.g. neighbors, solar wind and power, or
 // if the system is inhabited.
-void System::UpdateSystem(const Set<System> &systems, const set<double> &neighborDistances)
+void System::UpdateSystem(const SystemGrid &grid, const set<double> &neighborDistances)
 {
 	accessibleLinks.clear();
 	neighbors.clear();
@@ -548,15 +574,13 @@ void System::UpdateSystem(const Set<System> &systems, const set<double> &neighbo
 	// jump range that can be encountered.
 	if(jumpRange)
 	{
-		UpdateNeighbors(systems, jumpRange);
 		// Systems with a static jump range must also create a set for
 		// the DEFAULT_NEIGHBOR_DISTANCE to be returned for those systems
 		// which are visible from it.
-		UpdateNeighbors(systems, DEFAULT_NEIGHBOR_DISTANCE);
+		UpdateNeighbors(grid, {jumpRange, DEFAULT_NEIGHBOR_DISTANCE});
 	}
 	else
-		for(const double distance : neighborDistances)
-			UpdateNeighbors(systems, distance);
+		UpdateNeighbors(grid, neighborDistances);
 
 	// Cache the map star icons.
 	mapIcons.clear();
@@ -611,6 +635,23 @@ bool System::IsValid() const
 
 
 
+uint32_t System::Index() const
+{
+	return index.value;
+}
+
+
+
+// Get a number larger than the Index() of every system that exists.
+uint32_t System::IndexLimit()
+{
+	IndexPool &pool = Indices();
+	lock_guard<mutex> lock(pool.lock);
+	return pool.next;
+}
+
+
+
 const string &System::TrueName() const
 {
 	return trueName;
@@ -981,15 +1022,15 @@ bool System::HasTrade() const
 
 
 
-// Update the economy.
-void System::StepEconomy()
+// Produce a day's worth of trade goods, given the current supply of each
+// commodity, and decide how much of that supply is exported.
+void System::StepEconomy(double *supply, double *exports, size_t count)
 {
-	for(auto &it : trade)
+	for(size_t i = 0; i < count; ++i)
 	{
-		it.second.exports = EXPORT * it.second.supply;
-		it.second.supply *= KEEP;
-		it.second.supply += Random::Normal() * VOLUME;
-		it.second.Update();
+		exports[i] = EXPORT * supply[i];
+		supply[i] *= KEEP;
+		supply[i] += Random::Normal() * VOLUME;
 	}
 }
 
@@ -1023,6 +1064,40 @@ double System::Exports(const string &commodity) const
 
 
 
+vector<string> System::TradedCommodities() const
+{
+	vector<string> names;
+	names.reserve(trade.size());
+	for(const auto &it : trade)
+		names.push_back(it.first);
+	return names;
+}
+
+
+
+void System::GetTrade(double *supply, double *exports) const
+{
+	for(const auto &it : trade)
+	{
+		*supply++ = it.second.supply;
+		*exports++ = it.second.exports;
+	}
+}
+
+
+
+void System::SetTrade(const double *supply, const double *exports)
+{
+	for(auto &it : trade)
+	{
+		it.second.supply = *supply++;
+		it.second.exports = *exports++;
+		it.second.Update();
+	}
+}
+
+
+
 // Get the probabilities of various fleets entering this system.
 const vector<RandomEvent<Fleet>> &System::Fleets() const
 {
@@ -1143,26 +1218,29 @@ void System::LoadObjectHelper(const DataNode &node, StellarObject &object, bool
 // Once the star map is fully loaded or an event has changed systems
 // or links, figure out which stars are "neighbors" of this one, i.e.
 // close enough to see or to reach via jump drive.
-void System::UpdateNeighbors(const Set<System> &systems, double distance)
+void System::UpdateNeighbors(const SystemGrid &grid, const set<double> &distances)
 {
-	set<const System *> &neighborSet = neighbors[distance];
-
-	// Every accessible star system that is linked to this one is automatically a neighbor,
-	// even if it is farther away than the maximum distance.
-	for(const System *system : accessibleLinks)
-		neighborSet.insert(system);
+	if(distances.empty())
+		return;
 
-	// Any other star system that is within the neighbor distance is also a
-	// neighbor.
-	for(const auto &it : systems)
+	// Find every star system within the largest of the distances just once.
+	// They are sorted by distance, so the neighbors for each smaller distance
+	// are a prefix of that list.
+	const vector<pair<double, const System *>> nearby = grid.Near(position, *distances.rbegin());
+	for(const double distance : distances)
 	{
-		const System &other = it.second;
-		// Skip systems that are invalid or inaccessible.
-		if(!other.IsValid() || other.Inaccessible())
-			continue;
-
-		if(&other != this && other.Position().Distance(position) <= distance)
-			neighborSet.insert(&other);
+		set<const System *> &neighborSet = neighbors[distance];
+
+		// Every accessible star system that is linked to this one is automatically a neighbor,
+		// even if it is farther away than the maximum distance.
+		for(const System *system : accessibleLinks)
+			neighborSet.insert(system);
+
+		// Any other star system that is within the neighbor distance is also a
+		// neighbor.
+		for(auto it = nearby.begin(); it != nearby.end() && it->first <= distance; ++it)
+			if(it->second != this)
+				neighborSet.insert(it->second);
 	}
 }
 
@@ -1180,3 +1258,41 @@ void System::Price::Update()
 {
 	price = base + static_cast<int>(-100. * erf(supply / LIMIT));
 }
+
+
+
+System::DenseIndex::DenseIndex()
+{
+	IndexPool &pool = Indices();
+	lock_guard<mutex> lock(pool.lock);
+	if(pool.free.empty())
+		value = pool.next++;
+	else
+	{
+		value = pool.free.top();
+		pool.free.pop();
+	}
+}
+
+
+
+System::DenseIndex::DenseIndex(const DenseIndex &)
+	: DenseIndex()
+{
+}
+
+
+
+System::DenseIndex::~DenseIndex()
+{
+	IndexPool &pool = Indices();
+	lock_guard<mutex> lock(pool.lock);
+	pool.free.push(value);
+}
+
+
+
+System::DenseIndex &System::DenseIndex::operator=(const DenseIndex &)
+{
+	return *this;
+}
@@ -22,6 +22,8 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "StellarObject.h"
 #include "WeightedList.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <set>
 #include <string>
 #include <vector>
@@ -37,6 +39,7 @@ class Outfit;
 class Planet;
 class Ship;
 class Sprite;
+class SystemGrid;
 
 
 
@@ -78,13 +81,19 @@ public:
 	void Load(const DataNode &node, Set<Planet> &planets, const ConditionsStore *playerConditions);
 	// Update any information about the system that may have changed due to events,
 	// e.g. neighbors, solar wind and power, or if the system is inhabited.
-	void UpdateSystem(const Set<System> &systems, const std::set<double> &neighborDistances);
+	void UpdateSystem(const SystemGrid &grid, const std::set<double> &neighborDistances);
 
 	// Modify a system's links.
 	void Link(System *other);
 	void Unlink(System *other);
 
 	bool IsValid() const;
+	// Get a number that identifies this system object. Numbers are small and
+	// densely packed, so they can be used to index flat per-system arrays.
+	uint32_t Index() const;
+	// Get a number larger than the Index() of every system that exists, i.e.
+	// the size that a flat per-system array needs to have.
+	static uint32_t IndexLimit();
 	const std::string &TrueName() const;
 	void SetTrueName(const std::string &name);
 	// Get this system's name and position (in the star map).
@@ -169,11 +178,18 @@ public:
 	// Get the price of the given commodity in this system.
 	int Trade(const std::string &commodity) const;
 	bool HasTrade() const;
-	// Update the economy. Returns the amount of trade goods this system exports.
-	void StepEconomy();
+	// Produce a day's worth of trade goods, given the current supply of each
+	// commodity, and decide how much of that supply is exported.
+	static void StepEconomy(double *supply, double *exports, std::size_t count);
 	void SetSupply(const std::string &commodity, double tons);
 	double Supply(const std::string &commodity) const;
 	double Exports(const std::string &commodity) const;
+	// Get the names of all the commodities this system trades in. The supply
+	// and exports of every one of them can also be read or written at once,
+	// as arrays that list the commodities in this same order.
+	std::vector<std::string> TradedCommodities() const;
+	void GetTrade(double *supply, double *exports) const;
+	void SetTrade(const double *supply, const double *exports);
 
 	// Get the probabilities of various fleets entering this system.
 	const std::vector<RandomEvent<Fleet>> &Fleets() const;
@@ -196,7 +212,7 @@ private:
 	// Once the star map is fully loaded or an event has changed systems
 	// or links, figure out which stars are "neighbors" of this one, i.e.
 	// close enough to see or to reach via jump drive.
-	void UpdateNeighbors(const Set<System> &systems, double distance);
+	void UpdateNeighbors(const SystemGrid &grid, const std::set<double> &distances);
 
 
 private:
@@ -211,8 +227,23 @@ private:
 		double exports = 0.;
 	};
 
+	// Every System object, including a copy of another one, gets its own
+	// number when it is created. Assigning one system to another keeps the
+	// number of the system that is assigned to. The number of a destroyed
+	// system is given to the next one that is created.
+	class DenseIndex {
+	public:
+		DenseIndex();
+		DenseIndex(const DenseIndex &other);
+		~DenseIndex();
+		DenseIndex &operator=(const DenseIndex &other);
+
+		uint32_t value;
+	};
+
 
 private:
+	DenseIndex index;
 	bool isDefined = false;
 	bool hasPosition = false;
 	std::string trueName;
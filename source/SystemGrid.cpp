@@ -0,0 +1,98 @@
+/* SystemGrid.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SystemGrid.h"
+
+#include "Point.h"
+#include "System.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+
+
+SystemGrid::SystemGrid(const Set<System> &systems, double cellSize)
+	: cellSize(max(1., cellSize))
+{
+	for(const auto &it : systems)
+	{
+		const System &system = it.second;
+		// Invalid and inaccessible systems are never anyone's neighbors.
+		if(!system.IsValid() || system.Inaccessible())
+			continue;
+
+		const Point &position = system.Position();
+		cells[Key(Cell(position.X()), Cell(position.Y()))].push_back(&system);
+	}
+}
+
+
+
+// Get every accessible system within the given distance of the given point,
+// along with its distance, sorted from nearest to farthest.
+vector<pair<double, const System *>> SystemGrid::Near(const Point &center, double distance) const
+{
+	vector<pair<double, const System *>> result;
+	if(distance < 0.)
+		return result;
+
+	auto addCell = [&result, &center, distance](const vector<const System *> &cell)
+	{
+		for(const System *system : cell)
+		{
+			double d = system->Position().Distance(center);
+			if(d <= distance)
+				result.emplace_back(d, system);
+		}
+	};
+
+	const int64_t minX = Cell(center.X() - distance);
+	const int64_t maxX = Cell(center.X() + distance);
+	const int64_t minY = Cell(center.Y() - distance);
+	const int64_t maxY = Cell(center.Y() + distance);
+	// For very large distances (e.g. a system with a huge jump range) it is
+	// cheaper to check every occupied cell than to look up each covered one.
+	const double covered = (static_cast<double>(maxX - minX) + 1.) * (static_cast<double>(maxY - minY) + 1.);
+	if(covered > static_cast<double>(cells.size()))
+		for(const auto &it : cells)
+			addCell(it.second);
+	else
+		for(int64_t y = minY; y <= maxY; ++y)
+			for(int64_t x = minX; x <= maxX; ++x)
+			{
+				auto it = cells.find(Key(x, y));
+				if(it != cells.end())
+					addCell(it->second);
+			}
+
+	sort(result.begin(), result.end());
+	return result;
+}
+
+
+
+int64_t SystemGrid::Cell(double coordinate) const
+{
+	return static_cast<int64_t>(floor(coordinate / cellSize));
+}
+
+
+
+uint64_t SystemGrid::Key(int64_t x, int64_t y)
+{
+	return (static_cast<uint64_t>(x) << 32) ^ static_cast<uint32_t>(y);
+}
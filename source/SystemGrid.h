@@ -0,0 +1,51 @@
+/* SystemGrid.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Set.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Point;
+class System;
+
+
+
+// A uniform grid over the positions of every accessible star system on the map,
+// so that the systems close to a given point can be found without checking the
+// distance to every system in the galaxy.
+class SystemGrid {
+public:
+	// The cell size should be about the distance that will usually be searched.
+	SystemGrid(const Set<System> &systems, double cellSize);
+
+	// Get every accessible system within the given distance of the given point,
+	// along with its distance, sorted from nearest to farthest.
+	std::vector<std::pair<double, const System *>> Near(const Point &center, double distance) const;
+
+
+private:
+	int64_t Cell(double coordinate) const;
+	static uint64_t Key(int64_t x, int64_t y);
+
+
+private:
+	double cellSize;
+	std::unordered_map<uint64_t, std::vector<const System *>> cells;
+};
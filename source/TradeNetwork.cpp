@@ -0,0 +1,150 @@
+/* TradeNetwork.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "TradeNetwork.h"
+
+#include "System.h"
+
+#include <algorithm>
+
+using namespace std;
+
+
+
+void TradeNetwork::Build(Set<System> &systems, const vector<Trade::Commodity> &commodities)
+{
+	rows.clear();
+	entryStart.assign(1, 0);
+	entryColumns.clear();
+	entryNames.clear();
+	rowOf.clear();
+	linkStart.assign(1, 0);
+	links.clear();
+	linkCount.clear();
+
+	map<string, int> columnOf;
+	for(const Trade::Commodity &commodity : commodities)
+		columnOf.emplace(commodity.name, static_cast<int>(columnOf.size()));
+	columns = commodities.size();
+
+	// Give every system a row, and remember which row each system is in.
+	for(auto &it : systems)
+	{
+		System &system = it.second;
+		if(system.Index() >= rowOf.size())
+			rowOf.resize(system.Index() + 1, UINT32_MAX);
+		rowOf[system.Index()] = rows.size();
+		rows.push_back(&system);
+		linkCount.push_back(system.Links().size());
+
+		for(const string &name : system.TradedCommodities())
+		{
+			auto cit = columnOf.find(name);
+			entryColumns.push_back(cit == columnOf.end() ? -1 : cit->second);
+			entryNames.push_back(name);
+		}
+		entryStart.push_back(entryColumns.size());
+	}
+
+	// Links may lead to systems outside of the given set, but those do not
+	// take part in the exchange.
+	for(const System *system : rows)
+	{
+		for(const System *neighbor : system->Links())
+			if(neighbor->Index() < rowOf.size() && rowOf[neighbor->Index()] != UINT32_MAX)
+				links.push_back(rowOf[neighbor->Index()]);
+		linkStart.push_back(links.size());
+	}
+
+	entrySupply.resize(entryColumns.size());
+	entryExports.resize(entryColumns.size());
+	exports.resize(rows.size() * columns);
+	supply.resize(columns);
+}
+
+
+
+void TradeNetwork::Step(const map<const System *, map<string, int>> &purchases)
+{
+	for(size_t row = 0; row < rows.size(); ++row)
+		rows[row]->GetTrade(&entrySupply[entryStart[row]], &entryExports[entryStart[row]]);
+
+	// First, apply any purchases the player made.
+	for(const auto &pit : purchases)
+	{
+		uint32_t index = pit.first->Index();
+		if(index >= rowOf.size() || rowOf[index] == UINT32_MAX)
+			continue;
+		uint32_t row = rowOf[index];
+		for(uint32_t entry = entryStart[row]; entry < entryStart[row + 1]; ++entry)
+		{
+			auto cit = pit.second.find(entryNames[entry]);
+			if(cit != pit.second.end())
+				entrySupply[entry] -= cit->second;
+		}
+	}
+
+	// Then, have each system generate new goods for local use and trade.
+	for(size_t row = 0; row < rows.size(); ++row)
+		System::StepEconomy(&entrySupply[entryStart[row]], &entryExports[entryStart[row]],
+			entryStart[row + 1] - entryStart[row]);
+
+	// Gather the exports of every system into the matrix before sending out
+	// any of them, so that the systems that trade first do not get supplied
+	// by the systems that trade last.
+	fill(exports.begin(), exports.end(), 0.);
+	for(size_t row = 0; row < rows.size(); ++row)
+	{
+		double *rowExports = &exports[row * columns];
+		for(uint32_t entry = entryStart[row]; entry < entryStart[row + 1]; ++entry)
+			if(entryColumns[entry] >= 0)
+				rowExports[entryColumns[entry]] = entryExports[entry];
+	}
+
+	for(size_t row = 0; row < rows.size(); ++row)
+	{
+		if(linkStart[row] == linkStart[row + 1] || entryStart[row] == entryStart[row + 1])
+			continue;
+
+		fill(supply.begin(), supply.end(), 0.);
+		for(uint32_t entry = entryStart[row]; entry < entryStart[row + 1]; ++entry)
+			if(entryColumns[entry] >= 0)
+				supply[entryColumns[entry]] = entrySupply[entry];
+
+		// Add the neighbors' shares one neighbor at a time, in the same order
+		// as the system's links, so that every sum is done in the same order.
+		for(uint32_t link = linkStart[row]; link < linkStart[row + 1]; ++link)
+		{
+			const double scale = linkCount[links[link]];
+			if(!scale)
+				continue;
+			const double *neighborExports = &exports[links[link] * columns];
+			for(size_t column = 0; column < columns; ++column)
+				supply[column] += neighborExports[column] / scale;
+		}
+
+		for(uint32_t entry = entryStart[row]; entry < entryStart[row + 1]; ++entry)
+			if(entryColumns[entry] >= 0)
+				entrySupply[entry] = supply[entryColumns[entry]];
+	}
+}
+
+
+
+void TradeNetwork::Commit() const
+{
+	for(size_t row = 0; row < rows.size(); ++row)
+		rows[row]->SetTrade(&entrySupply[entryStart[row]], &entryExports[entryStart[row]]);
+}
@@ -0,0 +1,77 @@
+/* TradeNetwork.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Set.h"
+#include "Trade.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+class System;
+
+
+
+// The hyperspace links and traded commodities of every system, laid out so
+// that the daily exchange of trade goods between neighboring systems does not
+// need to look anything up by name. Each system is a row and each commodity
+// is a column of a dense matrix, and the links of each system are stored as
+// one contiguous range of neighbor rows. The network must be rebuilt whenever
+// systems, links, or the commodities a system trades in change.
+//
+// A day of trade is calculated in two parts: Step() only reads the systems,
+// so it may run on another thread while the game goes on, and Commit() then
+// gives the systems their new supply and exports.
+class TradeNetwork {
+public:
+	void Build(Set<System> &systems, const std::vector<Trade::Commodity> &commodities);
+
+	// Calculate the next day of trade: apply the given purchases, have each
+	// system produce new goods, and then give each system a share of the
+	// exports of each of its neighbors. A neighbor's exports are split evenly
+	// among all the systems it links to.
+	void Step(const std::map<const System *, std::map<std::string, int>> &purchases);
+	// Update every system with the results of the last Step().
+	void Commit() const;
+
+
+private:
+	std::vector<System *> rows;
+	std::size_t columns = 0;
+
+	// The commodities each system trades in, as a range of entries per row.
+	// Each entry holds the column of that commodity, or -1 if it is not one
+	// of the standard commodities.
+	std::vector<uint32_t> entryStart;
+	std::vector<int> entryColumns;
+	std::vector<std::string> entryNames;
+	// The row of each system, indexed by System::Index().
+	std::vector<uint32_t> rowOf;
+	// The links of each system, as a range of neighbor rows per row, and the
+	// number of links of each system.
+	std::vector<uint32_t> linkStart;
+	std::vector<uint32_t> links;
+	std::vector<double> linkCount;
+
+	// Storage for the daily step. The entry arrays hold the results.
+	std::vector<double> entrySupply;
+	std::vector<double> entryExports;
+	std::vector<double> exports;
+	std::vector<double> supply;
+};
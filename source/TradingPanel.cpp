@@ -158,7 +158,7 @@ void TradingPanel::Draw()
 		font.Draw(str, Point(MIN_X + NAME_X, lastY), unselected);
 	}
 
-	const SystemEconomy &economy = GameData::GetEconomicManager().GetSystemEconomy(&system);
+	const SystemEconomy &economy = GameData::GetEconomicManager().ReadSystemEconomy(&system);
 	const Government *gov = system.GetGovernment();
 	double reputation = gov ? gov->Reputation() : 0.0;
 	bool isBlackMarket = economy.IsBlackMarketOnly();
@@ -299,7 +299,7 @@ bool TradingPanel::KeyDown(SDL_Keycode key, Uint16 mod, const Command &command,
 		Buy(1000000000);
 	else if(key == 'e' || key == 'S' || (key == 's' && (mod & KMOD_SHIFT)))
 	{
-		const SystemEconomy &economy = GameData::GetEconomicManager().GetSystemEconomy(&system);
+		const SystemEconomy &economy = GameData::GetEconomicManager().ReadSystemEconomy(&system);
 		const Government *gov = system.GetGovernment();
 		bool isBlackMarket = economy.IsBlackMarketOnly();
 		double reputation = gov ? gov->Reputation() : 0.0;
@@ -415,7 +415,7 @@ void TradingPanel::Buy(int64_t amount)
 	if(!basePrice)
 		return;
 
-	const SystemEconomy &economy = GameData::GetEconomicManager().GetSystemEconomy(&system);
+	const SystemEconomy &economy = GameData::GetEconomicManager().ReadSystemEconomy(&system);
 	const Government *gov = system.GetGovernment();
 	bool buying = (amount > 0);
 	bool isBlackMarket = economy.IsBlackMarketOnly();
@@ -23,6 +23,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "PlayerInfo.h"
 #include "image/Sprite.h"
 #include "image/SpriteSet.h"
+#include "SystemGrid.h"
 #include "TaskQueue.h"
 
 #include <algorithm>
@@ -186,12 +187,16 @@ void UniverseObjects::Change(const DataNode &node, PlayerInfo &player)
 // (This must be done any time a GameEvent creates or moves a system.)
 void UniverseObjects::UpdateSystems()
 {
+	// Index the system positions first so that each system's neighbors can be
+	// found without comparing it against every other system.
+	const SystemGrid grid(systems, neighborDistances.empty()
+		? System::DEFAULT_NEIGHBOR_DISTANCE : *neighborDistances.rbegin());
 	for(auto &it : systems)
 	{
 		// Skip systems that have no name.
 		if(it.first.empty() || it.second.TrueName().empty())
 			continue;
-		it.second.UpdateSystem(systems, neighborDistances);
+		it.second.UpdateSystem(grid, neighborDistances);
 
 		// If there were changes to a system there might have been a change to a legacy
 		// wormhole which we must handle.
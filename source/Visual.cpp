@@ -54,17 +54,3 @@ Visual::Visual(const Effect &effect, Point pos, Point vel, Angle facing, Point h
 	if(effect.inheritsZoom)
 		scale *= inheritedZoom;
 }
-
-
-
-// Step the effect forward.
-void Visual::Move()
-{
-	if(lifetime-- <= 0)
-		MarkForRemoval();
-	else
-	{
-		position += velocity;
-		angle += spin;
-	}
-}
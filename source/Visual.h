@@ -40,11 +40,11 @@ public:
 	// Point Unit() const;
 	// double Zoom() const;
 
-	// Step the effect forward.
-	void Move();
-
 
 private:
 	Angle spin;
 	int lifetime = 0;
+
+	// Visuals are stepped forward by the ParticleSystem they are added to.
+	friend class ParticleSystem;
 };
@@ -35,6 +35,13 @@ WitnessInfo::WitnessInfo(const shared_ptr<Ship> &ship, const Government *gov,
 
 
 
+void WitnessResult::Clear()
+{
+	witnesses.clear();
+}
+
+
+
 void WitnessResult::AddWitness(const WitnessInfo &witness)
 {
 	witnesses.push_back(witness);
@@ -169,16 +176,12 @@ bool WitnessReport::Step()
 
 
 
-bool WitnessReport::EliminateWitness(const Ship *ship)
+bool WitnessReport::EliminateWitness(const SlotHandle &ship)
 {
 	if(!canBeSuppressed)
 		return false;
 
-	auto it = find_if(activeWitnesses.begin(), activeWitnesses.end(),
-		[ship](const shared_ptr<Ship> &s) { return s.get() == ship; });
-
-	if(it != activeWitnesses.end())
-		activeWitnesses.erase(it);
+	activeWitnesses.erase(ship);
 
 	return AllWitnessesEliminated();
 }
@@ -200,6 +203,21 @@ WitnessResult WitnessSystem::CheckWitnesses(
 	double customRange)
 {
 	WitnessResult result;
+	CheckWitnesses(result, eventLocation, perpetrator, victim, nearbyShips, customRange);
+	return result;
+}
+
+
+
+void WitnessSystem::CheckWitnesses(
+	WitnessResult &result,
+	const Point &eventLocation,
+	const Ship *perpetrator,
+	const Ship *victim,
+	const list<shared_ptr<Ship>> &nearbyShips,
+	double customRange)
+{
+	result.Clear();
 
 	for(const auto &ship : nearbyShips)
 	{
@@ -230,8 +248,6 @@ WitnessResult WitnessSystem::CheckWitnesses(
 
 		result.AddWitness(WitnessInfo(ship, gov, distance, canReport, hasSensors, clarity));
 	}
-
-	return result;
 }
 
 
@@ -346,7 +362,38 @@ bool WitnessSystem::WouldReport(const Ship &witness, const Government *victimGov
 
 void WitnessSystem::QueueReport(const WitnessReport &report)
 {
-	pendingReports.push_back(report);
+	const ReportKey key(report.reportingGov, report.victimGov, report.system, report.eventType);
+	auto it = reportsByKey.find(key);
+	WitnessReport *pending = (it != reportsByKey.end()) ? pendingReports.Get(it->second) : nullptr;
+
+	SlotHandle handle;
+	if(pending)
+	{
+		// Fold this report into the pending one. The combined report can only
+		// be suppressed by eliminating the witnesses of both.
+		handle = it->second;
+		pending->reputationImpact += report.reputationImpact;
+		pending->count += report.count;
+		pending->canBeSuppressed = pending->canBeSuppressed && report.canBeSuppressed;
+	}
+	else
+	{
+		handle = pendingReports.Insert(report);
+		pending = pendingReports.Get(handle);
+		pending->activeWitnesses.clear();
+		reportsByKey[key] = handle;
+
+		const uint64_t due = frame + max(1, report.framesRemaining);
+		wheel[due % WHEEL_SIZE].emplace_back(handle, due);
+	}
+
+	for(const SlotHandle &witness : report.activeWitnesses)
+		if(pending->activeWitnesses.insert(witness).second)
+			reportsByWitness[witness].push_back(handle);
+
+	// A report that nobody is left to file is dropped right away.
+	if(pending->AllWitnessesEliminated())
+		Erase(handle);
 }
 
 
@@ -355,26 +402,27 @@ vector<WitnessReport> WitnessSystem::StepReports()
 {
 	vector<WitnessReport> ready;
 
-	auto it = pendingReports.begin();
-	while(it != pendingReports.end())
+	++frame;
+	vector<pair<SlotHandle, uint64_t>> &bucket = wheel[frame % WHEEL_SIZE];
+	for(size_t i = 0; i < bucket.size(); )
 	{
-		// Check if all witnesses were eliminated.
-		if(it->AllWitnessesEliminated())
+		const auto [handle, due] = bucket[i];
+		const WitnessReport *report = pendingReports.Get(handle);
+		// Reports that were suppressed or cleared are simply dropped, and ones
+		// due on a later turn of the wheel stay in their bucket.
+		if(report && due > frame)
 		{
-			it = pendingReports.erase(it);
+			++i;
 			continue;
 		}
-
-		// Step the report.
-		if(it->Step())
+		if(report)
 		{
-			ready.push_back(*it);
-			it = pendingReports.erase(it);
-		}
-		else
-		{
-			++it;
+			ready.push_back(*report);
+			ready.back().framesRemaining = 0;
+			Erase(handle);
 		}
+		bucket[i] = bucket.back();
+		bucket.pop_back();
 	}
 
 	return ready;
@@ -382,7 +430,7 @@ vector<WitnessReport> WitnessSystem::StepReports()
 
 
 
-const vector<WitnessReport> &WitnessSystem::GetPendingReports() const
+const SlotMap<WitnessReport> &WitnessSystem::GetPendingReports() const
 {
 	return pendingReports;
 }
@@ -391,13 +439,54 @@ const vector<WitnessReport> &WitnessSystem::GetPendingReports() const
 
 void WitnessSystem::NotifyShipDestroyed(const Ship *ship)
 {
-	for(WitnessReport &report : pendingReports)
-		report.EliminateWitness(ship);
+	if(!ship)
+		return;
+
+	auto it = reportsByWitness.find(ship->Handle());
+	if(it == reportsByWitness.end())
+		return;
+
+	// Only the reports this ship witnessed are affected.
+	const vector<SlotHandle> reports = std::move(it->second);
+	reportsByWitness.erase(it);
+	for(const SlotHandle &handle : reports)
+	{
+		WitnessReport *report = pendingReports.Get(handle);
+		if(report && report->EliminateWitness(ship->Handle()))
+			Erase(handle);
+	}
 }
 
 
 
 void WitnessSystem::Clear()
 {
-	pendingReports.clear();
+	pendingReports.Clear();
+	reportsByKey.clear();
+	reportsByWitness.clear();
+	for(auto &bucket : wheel)
+		bucket.clear();
+}
+
+
+
+void WitnessSystem::Erase(const SlotHandle &handle)
+{
+	const WitnessReport *report = pendingReports.Get(handle);
+	if(!report)
+		return;
+
+	reportsByKey.erase(ReportKey(report->reportingGov, report->victimGov, report->system, report->eventType));
+	for(const SlotHandle &witness : report->activeWitnesses)
+	{
+		auto it = reportsByWitness.find(witness);
+		if(it == reportsByWitness.end())
+			continue;
+		vector<SlotHandle> &reports = it->second;
+		reports.erase(std::remove(reports.begin(), reports.end(), handle), reports.end());
+		if(reports.empty())
+			reportsByWitness.erase(it);
+	}
+	// The report's entry in the timer wheel is dropped when its bucket comes up.
+	pendingReports.Erase(handle);
 }
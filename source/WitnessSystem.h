@@ -16,12 +16,18 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include "Point.h"
+#include "SlotMap.h"
 
 #include <cstdint>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 class Government;
@@ -84,6 +90,9 @@ class WitnessResult {
 public:
 	WitnessResult() = default;
 
+	// Remove all witnesses, keeping the memory for reuse.
+	void Clear();
+
 	// Add a witness to this result.
 	void AddWitness(const WitnessInfo &witness);
 
@@ -127,7 +136,9 @@ private:
 
 
 
-// A pending report that will affect reputation after a delay.
+// A pending report that will affect reputation after a delay. While a report is
+// queued in the WitnessSystem, any further reports of the same kind of event
+// against the same government in the same system are merged into it.
 struct WitnessReport {
 	// The government filing the report.
 	const Government *reportingGov = nullptr;
@@ -135,16 +146,19 @@ struct WitnessReport {
 	const Government *victimGov = nullptr;
 	// The type of event being reported.
 	int eventType = 0;
-	// Frames remaining until the report is processed.
+	// Frames remaining until the report is processed. Once the report is queued,
+	// the WitnessSystem tracks the frame it is due on instead.
 	int framesRemaining = 0;
 	// The system where the event occurred.
 	const System *system = nullptr;
 	// Reputation impact when processed.
 	double reputationImpact = 0.0;
+	// The number of offenses this report covers.
+	int count = 1;
 	// Whether this report can still be suppressed.
 	bool canBeSuppressed = true;
-	// The witnesses who can still report (for suppression).
-	std::vector<std::shared_ptr<Ship>> activeWitnesses;
+	// The handles of the witnesses who can still report (for suppression).
+	std::unordered_set<SlotHandle, SlotHandle::Hash> activeWitnesses;
 
 	WitnessReport() = default;
 	WitnessReport(const Government *reportingGov, const Government *victimGov,
@@ -154,7 +168,7 @@ struct WitnessReport {
 	bool Step();
 
 	// Mark a witness as eliminated. Returns true if report is now suppressed.
-	bool EliminateWitness(const Ship *ship);
+	bool EliminateWitness(const SlotHandle &ship);
 
 	// Check if all witnesses have been eliminated.
 	bool AllWitnessesEliminated() const;
@@ -178,6 +192,15 @@ public:
 		const Ship *victim,
 		const std::list<std::shared_ptr<Ship>> &nearbyShips,
 		double customRange = WitnessConstants::DEFAULT_WITNESS_RANGE);
+	// As above, but fill in the given result, which is cleared first. This lets
+	// callers that check for witnesses often reuse the same result.
+	static void CheckWitnesses(
+		WitnessResult &result,
+		const Point &eventLocation,
+		const Ship *perpetrator,
+		const Ship *victim,
+		const std::list<std::shared_ptr<Ship>> &nearbyShips,
+		double customRange = WitnessConstants::DEFAULT_WITNESS_RANGE);
 
 	// Calculate if a specific ship can witness an event at a location.
 	static bool CanWitness(
@@ -202,14 +225,15 @@ public:
 	// Determine if a ship would report a crime to authorities.
 	static bool WouldReport(const Ship &witness, const Government *victimGov);
 
-	// Queue a witness report for delayed processing.
+	// Queue a witness report for delayed processing. If a matching report is
+	// already pending, this one is merged into it and is due when it is.
 	void QueueReport(const WitnessReport &report);
 
 	// Step all pending reports. Returns reports ready to be processed.
 	std::vector<WitnessReport> StepReports();
 
 	// Get all pending reports.
-	const std::vector<WitnessReport> &GetPendingReports() const;
+	const SlotMap<WitnessReport> &GetPendingReports() const;
 
 	// Mark a ship as eliminated (updates all pending reports).
 	void NotifyShipDestroyed(const Ship *ship);
@@ -218,7 +242,29 @@ public:
 	void Clear();
 
 
+private:
+	// Reports are merged if they have the same reporting government, victim
+	// government, system and event type.
+	using ReportKey = std::tuple<const Government *, const Government *, const System *, int>;
+
+	// The timer wheel has one bucket per frame, covering the usual transmission
+	// time. Reports due further in the future wait for the wheel to come around.
+	static constexpr uint64_t WHEEL_SIZE = 64;
+
+
+private:
+	// Remove a report and every reference to it.
+	void Erase(const SlotHandle &handle);
+
+
 private:
 	// Pending reports waiting to be processed.
-	std::vector<WitnessReport> pendingReports;
+	SlotMap<WitnessReport> pendingReports;
+	// The pending report for each key.
+	std::map<ReportKey, SlotHandle> reportsByKey;
+	// The pending reports each witness could still file, by the witness's handle.
+	std::unordered_map<SlotHandle, std::vector<SlotHandle>, SlotHandle::Hash> reportsByWitness;
+	// Timer wheel of the pending reports, each with the frame it is due on.
+	std::vector<std::pair<SlotHandle, uint64_t>> wheel[WHEEL_SIZE];
+	uint64_t frame = 0;
 };
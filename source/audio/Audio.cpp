@@ -19,21 +19,27 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "supplier/effect/Fade.h"
 #include "../Files.h"
 #include "../Logger.h"
+#include "supplier/effect/Mixer.h"
 #include "Music.h"
 #include "player/MusicPlayer.h"
 #include "../Point.h"
+#include "../Preferences.h"
 #include "Sound.h"
+#include "SoundBank.h"
 
 #include <AL/al.h>
 #include <AL/alc.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -45,7 +51,6 @@ namespace {
 	class QueueEntry {
 	public:
 		void Add(Point position, SoundCategory category);
-		void Add(const QueueEntry &other);
 
 		Point sum;
 		double weight = 0.;
@@ -61,6 +66,18 @@ namespace {
 		player.Move(angle.X() * scale, angle.Y() * scale, -scale);
 	}
 
+	// Get the gain and left / right balance for a mixer voice that approximate
+	// what OpenAL does with a source placed by Move(). OpenAL's default distance
+	// model attenuates a source by the inverse of its distance.
+	pair<double, double> Placement(const QueueEntry &entry)
+	{
+		Point angle = entry.sum / entry.weight;
+		return {min(1., sqrt(entry.weight)), angle.X() / sqrt(angle.LengthSquared() + 1.)};
+	}
+
+	// Mix the queued sound effects instead of creating a player for each one.
+	void QueueVoices(bool isFastForward);
+
 	// Thread entry point for loading the sound files.
 	void Load();
 
@@ -78,21 +95,55 @@ namespace {
 	map<SoundCategory, double> volume{{SoundCategory::MASTER, .125}};
 	map<SoundCategory, double> cachedVolume;
 
-	// This queue keeps track of sounds that have been requested to play. Each
-	// added sound is "deferred" until the next audio position update to make
-	// sure that all sounds from a given frame start at the same time.
+	// This queue keeps track of sounds that have been requested to play. It is
+	// only ever accessed from the main thread.
 	map<const Sound *, QueueEntry> soundQueue;
-	map<const Sound *, QueueEntry> deferred;
 	thread::id mainThreadID;
 
+	// A sound requested by a thread other than the main one. These are kept
+	// small, because the calculation thread may request thousands of sounds in
+	// a single step.
+	class SoundEvent {
+	public:
+		const Sound *sound;
+		float x;
+		float y;
+		SoundCategory category;
+	};
+
+	// Sounds requested from other threads are written to this ring buffer
+	// without taking any locks, and are added to the sound queue by the main
+	// thread. Only one other thread may request sounds at a time. Each event is
+	// "deferred" until the next audio position update to make sure that all
+	// sounds from a given frame start at the same time.
+	constexpr size_t EVENT_CAPACITY = 8192;
+	array<SoundEvent, EVENT_CAPACITY> events;
+	// The total number of events that have been written and read. Each event is
+	// stored in the slot given by its number modulo the capacity.
+	atomic<size_t> eventsWritten = 0;
+	atomic<size_t> eventsRead = 0;
+	// The number of events that had been written at the last position update.
+	size_t eventsPublished = 0;
+
 	// Sound resources that have been loaded from files.
 	map<string, Sound> sounds;
+	// The sound banks that some of those sounds are mapped from.
+	vector<unique_ptr<SoundBank>> banks;
 
 	/// The active audio sources
 	vector<shared_ptr<AudioPlayer>> players;
 	/// The looping players for reuse. Looping sources always have the Fade effect.
 	map<const Sound *, shared_ptr<AudioPlayer>> loopingPlayers;
 
+	/// If software mixing is turned on, every sound effect is mixed into the
+	/// stream of this player instead of getting an OpenAL source of its own.
+	/// This player is also present in 'players'.
+	shared_ptr<AudioPlayer> mixerPlayer;
+	/// The mixer voices of the looping sounds that are playing.
+	map<const Sound *, uint64_t> loopingVoices;
+	/// The maximum number of sound effects that are mixed at once.
+	constexpr size_t MAX_VOICES = 32;
+
 	// Queue and thread for loading sound files in the background.
 	map<string, filesystem::path> loadQueue;
 	thread loadThread;
@@ -154,6 +205,20 @@ void Audio::LoadSounds(const vector<filesystem::path> &sources)
 {
 	for(const auto &source : sources)
 	{
+		// The sounds in a sound bank are ready to use right away, and override
+		// any sounds of the same name from earlier sources.
+		auto bank = make_unique<SoundBank>();
+		if(bank->Open(source))
+		{
+			unique_lock<mutex> lock(audioMutex);
+			for(const auto &[name, entry] : bank->Entries())
+			{
+				sounds[name].Load(name, entry);
+				loadQueue.erase(name);
+				loadQueue.erase(name + "@3x");
+			}
+		}
+
 		filesystem::path root = source / "sounds";
 		vector<filesystem::path> files = Files::RecursiveList(root);
 		for(const auto &path : files)
@@ -165,9 +230,16 @@ void Audio::LoadSounds(const vector<filesystem::path> &sources)
 				string name = (path.parent_path() / path.stem()).lexically_relative(root).generic_string();
 				if(name.ends_with('~'))
 					name.resize(name.length() - 1);
+				// Files that are already in the bank only need to be loaded if
+				// they were changed after the bank was built.
+				string baseName = name.ends_with("@3x") ? name.substr(0, name.length() - 3) : name;
+				if(bank->Entries().contains(baseName) && Files::Timestamp(path) <= bank->Timestamp())
+					continue;
 				loadQueue[name] = path;
 			}
 		}
+		if(!bank->Entries().empty())
+			banks.emplace_back(std::move(bank));
 	}
 	// Begin loading the files.
 	if(!loadQueue.empty())
@@ -235,7 +307,7 @@ const Sound *Audio::Get(const string &name)
 
 
 
-// Set the listener's position, and also update any sounds that have been
+// Set the listener's position, and also release any sounds that have been
 // added but deferred because they were added from a thread other than the
 // main one (the one that called Init()).
 void Audio::Update(const Point &listenerPosition)
@@ -245,9 +317,7 @@ void Audio::Update(const Point &listenerPosition)
 
 	listener = listenerPosition;
 
-	for(const auto &it : deferred)
-		soundQueue[it.first].Add(it.second);
-	deferred.clear();
+	eventsPublished = eventsWritten.load(memory_order_acquire);
 }
 
 
@@ -273,8 +343,15 @@ void Audio::Play(const Sound *sound, const Point &position, SoundCategory catego
 		soundQueue[sound].Add(position - listener, category);
 	else
 	{
-		unique_lock<mutex> lock(audioMutex);
-		deferred[sound].Add(position - listener, category);
+		size_t written = eventsWritten.load(memory_order_relaxed);
+		// If the main thread has fallen this far behind, drop the sound.
+		if(written - eventsRead.load(memory_order_acquire) >= EVENT_CAPACITY)
+			return;
+
+		Point offset = position - listener;
+		events[written % EVENT_CAPACITY] = {sound, static_cast<float>(offset.X()),
+			static_cast<float>(offset.Y()), category};
+		eventsWritten.store(written + 1, memory_order_release);
 	}
 }
 
@@ -380,6 +457,35 @@ void Audio::Step(bool isFastForward)
 	}
 	pauseChangeCount = 0;
 
+	// Add the sounds that other threads requested before the last position
+	// update to the queue.
+	size_t read = eventsRead.load(memory_order_relaxed);
+	for( ; read != eventsPublished; ++read)
+	{
+		const SoundEvent &event = events[read % EVENT_CAPACITY];
+		soundQueue[event.sound].Add(Point(event.x, event.y), event.category);
+	}
+	eventsRead.store(read, memory_order_release);
+
+	// Start or stop mixing sound effects in software if that setting changed.
+	bool useMixer = Preferences::Has("Software sound mixing");
+	if(useMixer && !mixerPlayer)
+	{
+		mixerPlayer = make_shared<AudioPlayer>(SoundCategory::MASTER, make_unique<Mixer>(MAX_VOICES), false);
+		mixerPlayer->Init();
+		mixerPlayer->Play();
+		players.emplace_back(mixerPlayer);
+	}
+	else if(!useMixer && mixerPlayer)
+	{
+		static_cast<Mixer *>(mixerPlayer->Supplier())->Clear();
+		mixerPlayer->Stop();
+		mixerPlayer.reset();
+		loopingVoices.clear();
+	}
+	if(mixerPlayer)
+		QueueVoices(isFastForward);
+
 	// For each sound that is looping, see if it is going to continue. For other
 	// sounds, check if they are done playing.
 	for(auto it = loopingPlayers.begin(); it != loopingPlayers.end();)
@@ -458,10 +564,13 @@ void Audio::Quit()
 	// Now, stop and delete any OpenAL sources that are playing.
 	players.clear();
 	loopingPlayers.clear();
+	mixerPlayer.reset();
+	loopingVoices.clear();
 	musicPlayer.reset();
 
 	// Free the memory buffers for all the sound resources.
 	sounds.clear();
+	banks.clear();
 
 	// Close the connection to the OpenAL library.
 	if(context)
@@ -491,12 +600,41 @@ namespace {
 		this->category = category;
 	}
 
-	// Combine two queue entries.
-	void QueueEntry::Add(const QueueEntry &other)
+	// Mix the queued sound effects instead of creating a player for each one.
+	void QueueVoices(bool isFastForward)
 	{
-		sum += other.sum;
-		weight += other.weight;
-		category = other.category;
+		Mixer &mixer = *static_cast<Mixer *>(mixerPlayer->Supplier());
+
+		// Looping sounds keep their voice for as long as they are requested.
+		// If a voice was culled, the sound is added again below.
+		for(auto it = loopingVoices.begin(); it != loopingVoices.end();)
+		{
+			const auto &[sound, id] = *it;
+			auto queueIt = soundQueue.find(sound);
+			if(queueIt != soundQueue.end())
+			{
+				auto [gain, balance] = Placement(queueIt->second);
+				if(mixer.SetVoice(id, gain * Audio::Volume(queueIt->second.category), balance))
+				{
+					soundQueue.erase(queueIt);
+					++it;
+					continue;
+				}
+			}
+			mixer.StopVoice(id);
+			it = loopingVoices.erase(it);
+		}
+
+		for(const auto &[sound, entry] : soundQueue)
+		{
+			unique_ptr<AudioSupplier> supplier = sound->CreateSupplier();
+			supplier->Set3x(isFastForward);
+			auto [gain, balance] = Placement(entry);
+			uint64_t id = mixer.AddVoice(std::move(supplier), gain * Audio::Volume(entry.category), balance);
+			if(id && sound->IsLooping())
+				loopingVoices.emplace(sound, id);
+		}
+		soundQueue.clear();
 	}
 
 	// Thread entry point for loading sounds.
@@ -27,8 +27,9 @@ class Sound;
 
 
 // This class is a collection of global functions for handling audio. A sound
-// can be played from any point in the code, and from any thread, just by
-// specifying the name of the sound to play. Most sounds will come from a
+// can be played from any point in the code just by specifying the name of the
+// sound to play. Sounds may be played from the main thread and from one other
+// thread (i.e. the one running the game's calculations) at a time. Most sounds will come from a
 // "source" at a certain position, and their volume and left / right balance is
 // adjusted based on how far they are from the observer. Sounds that are not
 // marked as looping will play once, then stop; looping sounds continue until
@@ -42,7 +42,7 @@ bool Sound::Load(const filesystem::path &path, const string &name)
 
 	isLooped = path.stem().string().ends_with('~');
 	bool isFast = isLooped ? path.stem().string().ends_with("@3x~") : path.stem().string().ends_with("@3x");
-	vector<AudioSupplier::sample_t> &buf = isFast ? buffer3x : buffer;
+	Samples &samples = isFast ? buffer3x : buffer;
 
 	shared_ptr<iostream> in = Files::Open(path);
 	if(!in)
@@ -55,22 +55,26 @@ bool Sound::Load(const filesystem::path &path, const string &name)
 		return false;
 	}
 
-	// Read 16-bit mono from the file.
-	vector<char> data(bytes);
-	in->read(data.data(), bytes);
-
-	// Store 16-bit stereo buffer.
-	buf.resize(2 * data.size() / sizeof(AudioSupplier::sample_t));
-	for(size_t i = 0; i < buf.size() / 2; ++i)
-	{
-		buf[2 * i] = reinterpret_cast<AudioSupplier::sample_t *>(data.data())[i];
-		buf[2 * i + 1] = reinterpret_cast<AudioSupplier::sample_t *>(data.data())[i];
-	}
+	// Read 16-bit mono from the file. It is only turned into stereo as it is played.
+	samples.loaded.resize(bytes / sizeof(AudioSupplier::sample_t));
+	in->read(reinterpret_cast<char *>(samples.loaded.data()), samples.loaded.size() * sizeof(AudioSupplier::sample_t));
+	samples.mapped = {};
 	return true;
 }
 
 
 
+// Use the samples of a sound from a sound bank. The bank must outlive this sound.
+void Sound::Load(const string &name, const SoundBank::Entry &entry)
+{
+	this->name = name;
+	isLooped = entry.isLooping;
+	buffer = Samples{{}, entry.buffer};
+	buffer3x = Samples{{}, entry.buffer3x};
+}
+
+
+
 const string &Sound::Name() const
 {
 	return name;
@@ -78,16 +82,18 @@ const string &Sound::Name() const
 
 
 
-const vector<AudioSupplier::sample_t> &Sound::Buffer() const
+span<const AudioSupplier::sample_t> Sound::Buffer() const
 {
-	return buffer.empty() ? buffer3x : buffer;
+	span<const AudioSupplier::sample_t> samples = buffer.View();
+	return samples.empty() ? buffer3x.View() : samples;
 }
 
 
 
-const vector<AudioSupplier::sample_t> &Sound::Buffer3x() const
+span<const AudioSupplier::sample_t> Sound::Buffer3x() const
 {
-	return buffer3x.empty() ? buffer : buffer3x;
+	span<const AudioSupplier::sample_t> samples = buffer3x.View();
+	return samples.empty() ? buffer.View() : samples;
 }
 
 
@@ -106,6 +112,13 @@ unique_ptr<AudioSupplier> Sound::CreateSupplier() const
 
 
 
+span<const AudioSupplier::sample_t> Sound::Samples::View() const
+{
+	return loaded.empty() ? mapped : span<const AudioSupplier::sample_t>(loaded);
+}
+
+
+
 namespace {
 	// Read a WAV header, and return the size of the data, in bytes. If the file
 	// is an unsupported format (anything but little-endian 16-bit PCM at 44100 HZ),
@@ -15,11 +15,14 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include "SoundBank.h"
 #include "supplier/AudioSupplier.h"
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 
 
@@ -28,19 +31,34 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 class Sound {
 public:
 	bool Load(const std::filesystem::path &path, const std::string &name);
+	// Use the samples of a sound from a sound bank. The bank must outlive this sound.
+	void Load(const std::string &name, const SoundBank::Entry &entry);
 
 	const std::string &Name() const;
 
-	const std::vector<AudioSupplier::sample_t> &Buffer() const;
-	const std::vector<AudioSupplier::sample_t> &Buffer3x() const;
+	// The samples of this sound, in 16-bit mono.
+	std::span<const AudioSupplier::sample_t> Buffer() const;
+	std::span<const AudioSupplier::sample_t> Buffer3x() const;
 	bool IsLooping() const;
 
 	std::unique_ptr<AudioSupplier> CreateSupplier() const;
 
 
+private:
+	// The samples of one version of the sound, which were either read from a
+	// file or are mapped from a sound bank.
+	class Samples {
+	public:
+		std::span<const AudioSupplier::sample_t> View() const;
+
+		std::vector<AudioSupplier::sample_t> loaded;
+		std::span<const AudioSupplier::sample_t> mapped;
+	};
+
+
 private:
 	std::string name;
-	std::vector<AudioSupplier::sample_t> buffer;
-	std::vector<AudioSupplier::sample_t> buffer3x;
+	Samples buffer;
+	Samples buffer3x;
 	bool isLooped = false;
 };
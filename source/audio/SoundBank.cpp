@@ -0,0 +1,307 @@
+/* SoundBank.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SoundBank.h"
+
+#include "../Files.h"
+#include "../Logger.h"
+#include "Sound.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+using namespace std;
+
+namespace {
+	// A bank is laid out as follows, with all numbers in little-endian order:
+	// - The magic string below, which also identifies the version of the format.
+	// - The number of sounds, in 4 bytes.
+	// - For each sound, the length of its name (4 bytes), its name, its flags
+	//   (4 bytes), then the offset from the start of the file and the number of
+	//   samples of its regular and its 3x samples (8 bytes each).
+	// - The samples themselves, in 16-bit mono. Each sound's samples begin at an
+	//   offset that is a multiple of ALIGNMENT.
+	const string MAGIC = "SNDBANK1";
+	const uint32_t LOOPING = 1;
+	const size_t ALIGNMENT = 8;
+
+	size_t Align(size_t size)
+	{
+		return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	}
+
+	void Write(string &out, uint64_t value, int bytes)
+	{
+		for(int i = 0; i < bytes; ++i)
+			out += static_cast<char>(value >> (8 * i));
+	}
+
+	// Read the index of a bank, checking that nothing lies outside of it.
+	class Reader {
+	public:
+		explicit Reader(const MappedFile &file)
+			: begin(file.Data()), it(file.Data()), end(file.Data() + file.Size()) {}
+
+		uint64_t Read(int bytes)
+		{
+			if(end - it < bytes)
+			{
+				isValid = false;
+				return 0;
+			}
+			uint64_t value = 0;
+			for(int i = 0; i < bytes; ++i)
+				value |= static_cast<uint64_t>(static_cast<unsigned char>(*it++)) << (8 * i);
+			return value;
+		}
+
+		string ReadString(size_t length)
+		{
+			if(static_cast<size_t>(end - it) < length)
+			{
+				isValid = false;
+				return {};
+			}
+			it += length;
+			return string(it - length, length);
+		}
+
+		span<const AudioSupplier::sample_t> ReadSamples()
+		{
+			uint64_t offset = Read(8);
+			uint64_t count = Read(8);
+			size_t size = end - begin;
+			if(offset % ALIGNMENT || offset > size || count > (size - offset) / sizeof(AudioSupplier::sample_t))
+			{
+				isValid = false;
+				return {};
+			}
+			return {reinterpret_cast<const AudioSupplier::sample_t *>(begin + offset), count};
+		}
+
+		bool IsValid() const
+		{
+			return isValid;
+		}
+
+
+	private:
+		const char *begin;
+		const char *it;
+		const char *end;
+		bool isValid = true;
+	};
+}
+
+
+
+// Get the path of the bank for the given resource folder.
+filesystem::path SoundBank::BankPath(const filesystem::path &source)
+{
+	return source / "sounds.bank";
+}
+
+
+
+// Load every sound in the given resource folder and write them into its
+// bank. The new bank is checked against the loaded sounds before it replaces
+// the old one.
+bool SoundBank::Build(const filesystem::path &source)
+{
+	if constexpr(endian::native != endian::little)
+	{
+		Logger::Log("Sound banks can only be built on little-endian systems.", Logger::Level::ERROR);
+		return false;
+	}
+
+	// Load the sounds, naming them the same way Audio::LoadSounds() does.
+	const filesystem::path root = source / "sounds";
+	map<string, Sound> sounds;
+	for(const filesystem::path &path : Files::RecursiveList(root))
+	{
+		if(path.extension() != ".wav")
+			continue;
+		string name = (path.parent_path() / path.stem()).lexically_relative(root).generic_string();
+		if(name.ends_with('~'))
+			name.resize(name.length() - 1);
+		if(name.ends_with("@3x"))
+			name.resize(name.length() - 3);
+		if(!sounds[name].Load(path, name))
+		{
+			Logger::Log("Unable to load sound \"" + name + "\" from path: " + path.string(), Logger::Level::ERROR);
+			return false;
+		}
+	}
+	if(sounds.empty())
+	{
+		Logger::Log("There are no sounds in \"" + root.string() + "\".", Logger::Level::ERROR);
+		return false;
+	}
+
+	// The size of the index is needed to know where the samples will begin.
+	size_t indexSize = MAGIC.size() + 4;
+	for(const auto &[name, sound] : sounds)
+		indexSize += 4 + name.size() + 4 + 4 * 8;
+	const size_t samplesBegin = Align(indexSize);
+
+	string index = MAGIC;
+	string samples;
+	Write(index, sounds.size(), 4);
+	for(const auto &[name, sound] : sounds)
+	{
+		Write(index, name.size(), 4);
+		index += name;
+		Write(index, sound.IsLooping() ? LOOPING : 0, 4);
+
+		// If a sound only has one version, both refer to the same samples.
+		span<const AudioSupplier::sample_t> buffer = sound.Buffer();
+		span<const AudioSupplier::sample_t> buffer3x = sound.Buffer3x();
+		uint64_t offset = samplesBegin + samples.size();
+		samples.append(reinterpret_cast<const char *>(buffer.data()), buffer.size_bytes());
+		samples.resize(Align(samples.size()), '\0');
+		uint64_t offset3x = offset;
+		if(buffer3x.data() != buffer.data())
+		{
+			offset3x = samplesBegin + samples.size();
+			samples.append(reinterpret_cast<const char *>(buffer3x.data()), buffer3x.size_bytes());
+			samples.resize(Align(samples.size()), '\0');
+		}
+		Write(index, offset, 8);
+		Write(index, buffer.size(), 8);
+		Write(index, offset3x, 8);
+		Write(index, buffer3x.size(), 8);
+	}
+	index.resize(samplesBegin, '\0');
+
+	const filesystem::path path = BankPath(source);
+	filesystem::path temporary = path;
+	temporary += ".tmp";
+	Files::WriteBinary(temporary, index + samples);
+
+	// Make sure that the game will see exactly the same sounds in the bank. The
+	// new bank must be unmapped again before it can be renamed.
+	bool isValid = true;
+	{
+		SoundBank bank;
+		if(!bank.OpenFile(temporary))
+		{
+			Logger::Log("Unable to read back the sound bank \"" + temporary.string() + "\".",
+				Logger::Level::ERROR);
+			isValid = false;
+		}
+		for(auto soundIt = sounds.begin(); isValid && soundIt != sounds.end(); ++soundIt)
+		{
+			const auto &[name, sound] = *soundIt;
+			auto it = bank.entries.find(name);
+			Sound mapped;
+			if(it != bank.entries.end())
+				mapped.Load(name, it->second);
+			if(it == bank.entries.end() || mapped.IsLooping() != sound.IsLooping()
+					|| !ranges::equal(mapped.Buffer(), sound.Buffer())
+					|| !ranges::equal(mapped.Buffer3x(), sound.Buffer3x()))
+			{
+				Logger::Log("Sound \"" + name + "\" does not match its copy in \"" + temporary.string() + "\".",
+					Logger::Level::ERROR);
+				isValid = false;
+			}
+		}
+	}
+	if(!isValid)
+	{
+		if(Files::Exists(temporary))
+			Files::Delete(temporary);
+		return false;
+	}
+
+	// Replacing the old bank by renaming leaves its contents intact for anyone
+	// who still has it mapped.
+	Files::Move(temporary, path);
+	Logger::Log("Wrote " + to_string(sounds.size()) + " sounds to \"" + path.string() + "\".",
+		Logger::Level::INFO);
+	return true;
+}
+
+
+
+// Map the bank of the given resource folder. Returns false if there is no
+// bank, or if it cannot be used.
+bool SoundBank::Open(const filesystem::path &source)
+{
+	return OpenFile(BankPath(source));
+}
+
+
+
+// The sounds in this bank, by name.
+const map<string, SoundBank::Entry> &SoundBank::Entries() const
+{
+	return entries;
+}
+
+
+
+// When this bank was last written.
+filesystem::file_time_type SoundBank::Timestamp() const
+{
+	return timestamp;
+}
+
+
+
+// Map the bank file at the given path.
+bool SoundBank::OpenFile(const filesystem::path &path)
+{
+	entries.clear();
+	file.Close();
+
+	if(!Files::Exists(path))
+		return false;
+	// The samples are used exactly as they are stored.
+	if constexpr(endian::native != endian::little)
+		return false;
+	if(!file.Open(path))
+	{
+		Logger::Log("Unable to map the sound bank \"" + path.string()
+			+ "\". Sound banks cannot be used from inside of zip files.", Logger::Level::WARNING);
+		return false;
+	}
+
+	Reader in(file);
+	bool isValid = (in.ReadString(MAGIC.size()) == MAGIC);
+	uint64_t count = in.Read(4);
+	for(uint64_t i = 0; isValid && i < count; ++i)
+	{
+		string name = in.ReadString(in.Read(4));
+		Entry entry;
+		entry.isLooping = in.Read(4) & LOOPING;
+		entry.buffer = in.ReadSamples();
+		entry.buffer3x = in.ReadSamples();
+		isValid = in.IsValid();
+		if(isValid)
+			entries.emplace(std::move(name), entry);
+	}
+	if(!isValid)
+	{
+		Logger::Log("The sound bank \"" + path.string() + "\" is damaged and will be ignored.",
+			Logger::Level::WARNING);
+		entries.clear();
+		file.Close();
+		return false;
+	}
+
+	timestamp = Files::Timestamp(path);
+	return true;
+}
@@ -0,0 +1,78 @@
+/* SoundBank.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../MappedFile.h"
+#include "supplier/AudioSupplier.h"
+
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+
+
+
+// A packed file holding the samples of every sound in one resource folder (the
+// game's own resources or a plugin), named "sounds.bank" and placed next to its
+// "sounds" folder. A bank is memory-mapped instead of being read, so none of
+// its sounds have to be loaded at startup, and only the parts of it that are
+// actually played take up memory. Banks are created with the command-line
+// option "--build-sound-bank".
+class SoundBank {
+public:
+	// The samples of one sound in the bank, in 16-bit mono.
+	class Entry {
+	public:
+		std::span<const AudioSupplier::sample_t> buffer;
+		std::span<const AudioSupplier::sample_t> buffer3x;
+		bool isLooping = false;
+	};
+
+
+public:
+	// Get the path of the bank for the given resource folder.
+	static std::filesystem::path BankPath(const std::filesystem::path &source);
+	// Load every sound in the given resource folder and write them into its
+	// bank. The new bank is written under a temporary name, read back and
+	// checked against the loaded sounds, and only then renamed over the old
+	// bank, so a bank that fails the check is never used, and a game that has
+	// the old bank mapped keeps reading it. Returns false, after logging the
+	// reason, if anything went wrong.
+	static bool Build(const std::filesystem::path &source);
+
+
+public:
+	// Map the bank of the given resource folder. Returns false if there is no
+	// bank, or if it cannot be used.
+	bool Open(const std::filesystem::path &source);
+
+	// The sounds in this bank, by name. Their samples remain valid for as long
+	// as this bank exists.
+	const std::map<std::string, Entry> &Entries() const;
+	// When this bank was last written.
+	std::filesystem::file_time_type Timestamp() const;
+
+
+private:
+	// Map the bank file at the given path.
+	bool OpenFile(const std::filesystem::path &path);
+
+
+private:
+	MappedFile file;
+	std::map<std::string, Entry> entries;
+	std::filesystem::file_time_type timestamp;
+};
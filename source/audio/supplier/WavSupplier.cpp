@@ -19,6 +19,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <cmath>
+#include <span>
 
 using namespace std;
 
@@ -38,7 +39,8 @@ size_t WavSupplier::MaxChunks() const
 	else if(wasStarted && !currentSample)
 		return 0;
 	else
-		return ceil(((is3x ? sound.Buffer3x() : sound.Buffer()).size() - currentSample) / static_cast<float>(OUTPUT_CHUNK));
+		return ceil(((is3x ? sound.Buffer3x() : sound.Buffer()).size() - currentSample)
+			/ static_cast<float>(OUTPUT_CHUNK / 2));
 }
 
 
@@ -57,7 +59,9 @@ vector<AudioSupplier::sample_t> WavSupplier::NextDataChunk()
 	if(!currentSample && wasStarted && !isLooping)
 		return samples;
 
-	size_t currentSampleCount = 0;
+	// Sounds are stored in mono, so each input sample is copied to both channels.
+	const size_t frames = samples.size() / 2;
+	size_t currentFrame = 0;
 	do {
 		// If restarting the buffer, check 3x status.
 		if(!currentSample)
@@ -65,12 +69,16 @@ vector<AudioSupplier::sample_t> WavSupplier::NextDataChunk()
 			is3x = nextPlaybackIs3x;
 			wasStarted = true;
 		}
-		const vector<sample_t> &input = is3x ? sound.Buffer3x() : sound.Buffer();
-		size_t readChunk = min(input.size() - currentSample, samples.size() - currentSampleCount);
-		std::copy_n(input.begin() + currentSample, readChunk, samples.begin() + currentSampleCount);
-		currentSampleCount += readChunk;
+		span<const sample_t> input = is3x ? sound.Buffer3x() : sound.Buffer();
+		size_t readChunk = min(input.size() - currentSample, frames - currentFrame);
+		for(size_t i = 0; i < readChunk; ++i)
+		{
+			samples[2 * (currentFrame + i)] = input[currentSample + i];
+			samples[2 * (currentFrame + i) + 1] = input[currentSample + i];
+		}
+		currentFrame += readChunk;
 		currentSample = (currentSample + readChunk) % input.size();
-	} while(currentSampleCount < samples.size() && isLooping);
+	} while(currentFrame < frames && isLooping);
 	return samples;
 }
 
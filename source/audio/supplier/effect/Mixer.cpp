@@ -0,0 +1,221 @@
+/* Mixer.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Mixer.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	/// The number of mixed chunks that are kept queued up for playback. This
+	/// is how far ahead of the game the mix can be.
+	constexpr size_t QUEUED_CHUNKS = 3;
+}
+
+
+
+Mixer::Mixer(size_t maxVoices)
+	: maxVoices(maxVoices)
+{
+}
+
+
+
+uint64_t Mixer::AddVoice(unique_ptr<AudioSupplier> source, double gain, double balance)
+{
+	if(gain < MIN_GAIN || !maxVoices)
+		return 0;
+
+	// If every voice is in use, drop the quietest one, unless the new voice
+	// would be even quieter.
+	if(VoiceCount() >= maxVoices)
+	{
+		Voice *quietest = nullptr;
+		for(Voice &voice : voices)
+			if(!voice.isStopping && (!quietest || voice.Priority() < quietest->Priority()))
+				quietest = &voice;
+		if(quietest->Priority() >= gain)
+			return 0;
+		quietest->targetLeft = 0.f;
+		quietest->targetRight = 0.f;
+		quietest->isStopping = true;
+	}
+
+	Voice &voice = voices.emplace_back();
+	voice.id = nextId++;
+	voice.source = std::move(source);
+	voice.source->Set3x(nextPlaybackIs3x);
+	SetGain(voice, gain, balance);
+	// New voices start at their full volume.
+	voice.left = voice.targetLeft;
+	voice.right = voice.targetRight;
+	return voice.id;
+}
+
+
+
+bool Mixer::SetVoice(uint64_t id, double gain, double balance)
+{
+	Voice *voice = Find(id);
+	if(!voice || voice->isStopping)
+		return false;
+
+	SetGain(*voice, gain, balance);
+	return true;
+}
+
+
+
+void Mixer::StopVoice(uint64_t id)
+{
+	Voice *voice = Find(id);
+	if(!voice)
+		return;
+
+	voice->targetLeft = 0.f;
+	voice->targetRight = 0.f;
+	voice->isStopping = true;
+}
+
+
+
+void Mixer::Clear()
+{
+	voices.clear();
+}
+
+
+
+size_t Mixer::VoiceCount() const
+{
+	return count_if(voices.begin(), voices.end(), [](const Voice &voice) { return !voice.isStopping; });
+}
+
+
+
+void Mixer::Set3x(bool is3x)
+{
+	AudioSupplier::Set3x(is3x);
+	for(const Voice &voice : voices)
+		voice.source->Set3x(nextPlaybackIs3x);
+}
+
+
+
+size_t Mixer::MaxChunks() const
+{
+	// The mixed stream never ends, even when there is nothing to play.
+	return QUEUED_CHUNKS;
+}
+
+
+
+size_t Mixer::AvailableChunks() const
+{
+	return QUEUED_CHUNKS;
+}
+
+
+
+vector<AudioSupplier::sample_t> Mixer::NextDataChunk()
+{
+	mix.assign(MIX_CHUNK, 0.f);
+	for(Voice &voice : voices)
+		voice.MixInto(mix);
+	erase_if(voices, [](const Voice &voice) { return voice.IsFinished(); });
+
+	vector<sample_t> result(MIX_CHUNK);
+	for(size_t i = 0; i < MIX_CHUNK; ++i)
+		result[i] = static_cast<sample_t>(clamp(mix[i], -32768.f, 32767.f));
+	return result;
+}
+
+
+
+void Mixer::Voice::MixInto(vector<float> &mix)
+{
+	// The gain changes linearly over the chunk, to avoid audible clicks. The
+	// gains are copied so the compiler knows the mix cannot overwrite them.
+	const float frames = mix.size() / 2;
+	const float startLeft = left;
+	const float startRight = right;
+	const float stepLeft = (targetLeft - left) / frames;
+	const float stepRight = (targetRight - right) / frames;
+
+	size_t done = 0;
+	while(done < mix.size())
+	{
+		if(position == input.size())
+		{
+			if(!source->MaxChunks() || !source->AvailableChunks())
+				break;
+			input = source->NextDataChunk();
+			position = 0;
+		}
+
+		// The input and the mix are both interleaved stereo. Keeping this loop
+		// free of branches (and counting frames in a type that converts to float
+		// in a single instruction) lets the compiler vectorize it.
+		const int count = min(input.size() - position, mix.size() - done) / 2;
+		const sample_t *in = input.data() + position;
+		float *out = mix.data() + done;
+		const int first = done / 2;
+		for(int i = 0; i < count; ++i)
+		{
+			const float t = first + i;
+			out[2 * i] += in[2 * i] * (startLeft + t * stepLeft);
+			out[2 * i + 1] += in[2 * i + 1] * (startRight + t * stepRight);
+		}
+		position += 2 * count;
+		done += 2 * count;
+		if(!count)
+			break;
+	}
+
+	left = targetLeft;
+	right = targetRight;
+}
+
+
+
+bool Mixer::Voice::IsFinished() const
+{
+	return isStopping || (position == input.size() && !source->MaxChunks());
+}
+
+
+
+float Mixer::Voice::Priority() const
+{
+	return max(targetLeft, targetRight);
+}
+
+
+
+Mixer::Voice *Mixer::Find(uint64_t id)
+{
+	auto it = find_if(voices.begin(), voices.end(), [id](const Voice &voice) { return voice.id == id; });
+	return it == voices.end() ? nullptr : &*it;
+}
+
+
+
+void Mixer::SetGain(Voice &voice, double gain, double balance)
+{
+	balance = clamp(balance, -1., 1.);
+	voice.targetLeft = gain * min(1., 1. - balance);
+	voice.targetRight = gain * min(1., 1. + balance);
+}
@@ -0,0 +1,104 @@
+/* Mixer.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "../AudioSupplier.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+
+/// Mixes any number of sound effects into a single stereo stream, so that they
+/// can all be played through one OpenAL source. Each voice has its own gain
+/// and left / right balance. Only a limited number of voices are mixed at once;
+/// when all of them are in use, the quietest voice is dropped to make room for
+/// a louder one, and voices that would be nearly inaudible are never added.
+class Mixer : public AudioSupplier {
+public:
+	/// How many samples to put in each chunk of mixed audio. This is shorter
+	/// than the chunks of other suppliers, so that newly added voices can be
+	/// heard sooner. This chunk size provides 2 in-game frames' worth of audio.
+	static constexpr size_t MIX_CHUNK = 1. / 60. * SAMPLE_RATE * 2 * 2;
+	/// Voices with a lower gain than this are culled.
+	static constexpr double MIN_GAIN = 1. / 512.;
+
+
+public:
+	explicit Mixer(size_t maxVoices);
+
+	/// Adds a voice with the given gain and balance (from -1 for the left
+	/// channel only to 1 for the right channel only). Returns the ID of the new
+	/// voice, or 0 if it was culled.
+	uint64_t AddVoice(std::unique_ptr<AudioSupplier> source, double gain, double balance);
+	/// Changes the gain and balance of a voice. The change is applied gradually
+	/// over the next chunk. Returns false if the voice is no longer playing.
+	bool SetVoice(uint64_t id, double gain, double balance);
+	/// Fades out the given voice over the next chunk, then removes it.
+	void StopVoice(uint64_t id);
+	/// Removes all voices immediately.
+	void Clear();
+
+	/// The number of voices that are playing and not being faded out.
+	size_t VoiceCount() const;
+
+	void Set3x(bool is3x) override;
+
+	// Inherited pure virtual methods
+	size_t MaxChunks() const override;
+	size_t AvailableChunks() const override;
+	std::vector<sample_t> NextDataChunk() override;
+
+
+private:
+	class Voice {
+	public:
+		/// Adds the next chunk of this voice to the given mix.
+		void MixInto(std::vector<float> &mix);
+		/// Check whether this voice has nothing more to contribute.
+		bool IsFinished() const;
+		/// The gain of the louder channel, used to pick which voices to drop.
+		float Priority() const;
+
+		uint64_t id = 0;
+		std::unique_ptr<AudioSupplier> source;
+		/// The part of the source's current chunk that has not been mixed yet.
+		std::vector<sample_t> input;
+		size_t position = 0;
+		/// The gain of each channel at the start of the next chunk, and the gain
+		/// they will have reached at the end of it.
+		float left = 0.f;
+		float right = 0.f;
+		float targetLeft = 0.f;
+		float targetRight = 0.f;
+		bool isStopping = false;
+	};
+
+
+private:
+	Voice *Find(uint64_t id);
+	static void SetGain(Voice &voice, double gain, double balance);
+
+
+private:
+	size_t maxVoices;
+	std::vector<Voice> voices;
+	uint64_t nextId = 1;
+	/// The mix is accumulated in floating point, so that loud voices only clip
+	/// once all of them have been added together.
+	std::vector<float> mix;
+};
@@ -21,6 +21,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "CustomEvents.h"
 #include "DataFile.h"
 #include "DataNode.h"
+#include "DataWriter.h"
 #include "Engine.h"
 #include "Files.h"
 #include "text/Font.h"
@@ -37,7 +38,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "Plugins.h"
 #include "Preferences.h"
 #include "PrintData.h"
+#include "SaveQueue.h"
 #include "Screen.h"
+#include "audio/SoundBank.h"
 #include "image/SpriteSet.h"
 #include "shader/SpriteShader.h"
 #include "TaskQueue.h"
@@ -54,6 +57,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <chrono>
 #include <iostream>
 #include <map>
+#include <sstream>
 
 #include <cassert>
 #include <future>
@@ -67,6 +71,7 @@ void PrintVersion();
 void GameLoop(PlayerInfo &player, TaskQueue &queue, const Conversation &conversation,
 	const string &testToRun, bool debugMode);
 Conversation LoadConversation(const PlayerInfo &player);
+int ConvertSave(const string &from, const string &to);
 void PrintTestsTable();
 
 
@@ -89,6 +94,9 @@ int main(int argc, char *argv[])
 	bool printData = false;
 	bool noTestMute = false;
 	string testToRunName;
+	string convertFrom;
+	string convertTo;
+	string soundBankSource;
 
 	// Whether the game has encountered errors while loading.
 	bool hasErrors = false;
@@ -126,10 +134,22 @@ int main(int argc, char *argv[])
 			printTests = true;
 		else if(arg == "--nomute")
 			noTestMute = true;
+		else if(arg == "--convert-save" && it[1] && it[2])
+		{
+			convertFrom = *++it;
+			convertTo = *++it;
+		}
+		else if(arg == "--build-sound-bank" && it[1])
+			soundBankSource = *++it;
 	}
 	printData = PrintData::IsPrintDataArgument(argv);
 	Files::Init(argv);
 
+	if(!convertFrom.empty())
+		return ConvertSave(convertFrom, convertTo);
+	if(!soundBankSource.empty())
+		return !SoundBank::Build(soundBankSource);
+
 	// Whether we are running an integration test.
 	const bool isTesting = !testToRunName.empty();
 	bool isConsoleOnly = loadOnly || printTests || printData;
@@ -242,11 +262,15 @@ int main(int argc, char *argv[])
 	}
 	catch(const exception &error)
 	{
+		SaveQueue::Wait();
 		Audio::Quit();
 		GameWindow::ExitWithError(error.what(), !isTesting);
 		return 1;
 	}
 
+	// Make sure any save that is still being written finishes before quitting.
+	SaveQueue::Wait();
+
 	// Remember the window state and preferences if quitting normally.
 	Preferences::Set("maximized", GameWindow::IsMaximized());
 	Preferences::Set("fullscreen", GameWindow::IsFullscreen());
@@ -528,6 +552,10 @@ void PrintHelp()
 	cerr << "    --tests: print table of available tests, then exit." << endl;
 	cerr << "    --test <name>: run given test from resources directory." << endl;
 	cerr << "    --nomute: don't mute the game while running tests." << endl;
+	cerr << "    --convert-save <input> <output>: convert a saved game from text to the compact"
+		" binary format, or from binary to text, then exit." << endl;
+	cerr << "    --build-sound-bank <path>: pack the sounds of the resource or plugin folder at the given"
+		" path into a sound bank, check it, then exit." << endl;
 	PrintData::Help();
 	cerr << endl;
 	cerr << "Report bugs to: <https://github.com/endless-sky/endless-sky/issues>" << endl;
@@ -551,6 +579,32 @@ void PrintVersion()
 
 
 
+// Convert a saved game (or any other data file) between the text and binary
+// encodings. Both encodings hold exactly the same data, so this is lossless
+// apart from any comments in a text file.
+int ConvertSave(const string &from, const string &to)
+{
+	string data = Files::Read(from);
+	if(data.empty())
+	{
+		cerr << "Unable to read \"" << from << "\"." << endl;
+		return 1;
+	}
+
+	istringstream in(data);
+	DataFile file(in);
+	{
+		DataWriter out(to);
+		if(!DataFile::IsBinary(data))
+			out.SetBinary();
+		for(const DataNode &node : file)
+			out.Write(node);
+	}
+	return 0;
+}
+
+
+
 Conversation LoadConversation(const PlayerInfo &player)
 {
 	const ConditionsStore *conditions = &player.Conditions();
@@ -16,6 +16,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "BatchDrawList.h"
 
 #include "BatchShader.h"
+#include "../Angle.h"
 #include "../Body.h"
 #include "../Screen.h"
 #include "../image/Sprite.h"
@@ -41,7 +42,11 @@ namespace {
 // Clear the list, also setting the global time step for animation.
 void BatchDrawList::Clear(int step, double zoom)
 {
-	data.clear();
+	// Keep each sprite's vertex buffer around, so that once the list has grown
+	// to its working size, building it again for the next frame does not need
+	// to allocate any memory. The set of sprites is finite, so this is bounded.
+	for(pair<const Sprite * const, vector<float>> &it : data)
+		it.second.clear();
 	this->step = step;
 	this->zoom = zoom;
 	isHighDPI = (Screen::IsHighResolution() ? zoom > .5 : zoom > 1.);
@@ -69,7 +74,7 @@ bool BatchDrawList::Add(const Body &body, float clip)
 	// we want it to be drawn with its center halfway to the target. For longer-lived projectiles, we
 	// expect the position to be the actual location of the projectile at that point in time.
 	Point position = (body.Position() + .5 * body.Velocity() - center) * zoom;
-	return Add(body, position, clip);
+	return Add(body, position, body.Unit(), clip);
 }
 
 
@@ -77,7 +82,15 @@ bool BatchDrawList::Add(const Body &body, float clip)
 // TODO: Once we have sprite reference positions, this method will not be needed.
 bool BatchDrawList::AddVisual(const Body &visual)
 {
-	return Add(visual, (visual.Position() - center) * zoom, 1.f);
+	return Add(visual, (visual.Position() - center) * zoom, visual.Unit(), 1.f);
+}
+
+
+
+// Add a visual whose position and facing are stored separately from it.
+bool BatchDrawList::AddVisual(const Body &visual, const Point &position, const Angle &facing)
+{
+	return Add(visual, (position - center) * zoom, facing.Unit() * (.5 * visual.Zoom()), 1.f);
 }
 
 
@@ -88,19 +101,19 @@ void BatchDrawList::Draw() const
 	BatchShader::Bind();
 
 	for(const pair<const Sprite * const, vector<float>> &it : data)
-		BatchShader::Add(it.first, isHighDPI, it.second);
+		if(!it.second.empty())
+			BatchShader::Add(it.first, isHighDPI, it.second);
 
 	BatchShader::Unbind();
 }
 
 
 
-bool BatchDrawList::Cull(const Body &body, const Point &position) const
+bool BatchDrawList::Cull(const Body &body, const Point &position, const Point &unit) const
 {
 	if(!body.HasSprite() || !body.Zoom())
 		return true;
 
-	Point unit = body.Unit();
 	// Cull sprites that are completely off screen, to reduce the number of draw
 	// calls that we issue (which may be the bottleneck on some systems).
 	Point size(
@@ -118,9 +131,9 @@ bool BatchDrawList::Cull(const Body &body, const Point &position) const
 
 
 
-bool BatchDrawList::Add(const Body &body, Point position, float clip)
+bool BatchDrawList::Add(const Body &body, Point position, Point unit, float clip)
 {
-	if(Cull(body, position))
+	if(Cull(body, position, unit))
 		return false;
 
 	// Get the data vector for this particular sprite.
@@ -129,7 +142,7 @@ bool BatchDrawList::Add(const Body &body, Point position, float clip)
 	float frame = body.GetFrame(step);
 
 	// Get unit vectors in the direction of the object's width and height.
-	Point unit = body.Unit() * zoom;
+	unit *= zoom;
 	Point uw = Point(-unit.Y(), unit.X()) * body.Width();
 	Point uh = unit * body.Height();
 
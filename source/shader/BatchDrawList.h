@@ -20,6 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include <map>
 #include <vector>
 
+class Angle;
 class Body;
 class Sprite;
 
@@ -36,6 +37,8 @@ public:
 	// Add an unswizzled object based on the Body class.
 	bool Add(const Body &body, float clip = 1.f);
 	bool AddVisual(const Body &visual);
+	// Add a visual whose position and facing are stored separately from it.
+	bool AddVisual(const Body &visual, const Point &position, const Angle &facing);
 
 	// Draw all the items in this list.
 	void Draw() const;
@@ -43,10 +46,10 @@ public:
 
 private:
 	// Determine if the given body should be drawn at all.
-	bool Cull(const Body &body, const Point &position) const;
+	bool Cull(const Body &body, const Point &position, const Point &unit) const;
 
-	// Add the given body at the given position.
-	bool Add(const Body &body, Point position, float clip);
+	// Add the given body at the given position, oriented along the given unit vector.
+	bool Add(const Body &body, Point position, Point unit, float clip);
 
 
 private:
@@ -21,15 +21,19 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 #include "../GameData.h"
 #include "../image/ImageBuffer.h"
 #include "../image/ImageFileData.h"
+#include "../LruCache.h"
 #include "../Point.h"
 #include "../Preferences.h"
 #include "../Screen.h"
 #include "Truncate.h"
+#include "WrappedText.h"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <vector>
 
 using namespace std;
 
@@ -37,20 +41,69 @@ namespace {
 	bool showUnderlines = false;
 	const int KERN = 2;
 
-	/// Shared VAO and VBO quad (0,0) -> (1,1)
+	/// Shared VAO and VBO that each string's glyph quads are streamed into.
 	GLuint vao = 0;
 	GLuint vbo = 0;
 
 	GLint colorI = 0;
 	GLint scaleI = 0;
-	GLint glyphSizeI = 0;
-	GLint glyphI = 0;
-	GLint aspectI = 0;
-	GLint positionI = 0;
 
 	GLint vertI;
 	GLint cornerI;
 
+	// The vertices of the string being drawn, reused from one string to the next.
+	vector<GLfloat> vertices;
+
+	// Truncating text takes a binary search over the possible lengths, building
+	// and measuring a new string at each step, and the same labels are truncated
+	// every frame, so the results are cached.
+	class TruncationKey {
+	public:
+		const Font *font;
+		int width;
+		Truncate truncate;
+		string text;
+
+		bool operator==(const TruncationKey &other) const = default;
+
+		class Hash {
+		public:
+			size_t operator()(const TruncationKey &key) const noexcept
+			{
+				size_t seed = hash<string>()(key.text);
+				seed ^= hash<const Font *>()(key.font) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+				seed ^= hash<int>()(key.width * 8 + static_cast<int>(key.truncate)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+				return seed;
+			}
+		};
+	};
+	LruCache<TruncationKey, pair<string, int>, TruncationKey::Hash> truncations(1024);
+	mutex truncationMutex;
+
+	// Append a glyph to the triangle strip. Each glyph is a quad, and
+	// consecutive quads are joined by degenerate triangles.
+	void AddGlyph(int glyph, float glyphs, GLfloat x, GLfloat y, GLfloat width, GLfloat height)
+	{
+		const GLfloat left = glyph / glyphs;
+		const GLfloat right = (glyph + 1) / glyphs;
+		const GLfloat corners[16] = {
+			x, y, left, 0.f,
+			x, y + height, left, 1.f,
+			x + width, y, right, 0.f,
+			x + width, y + height, right, 1.f
+		};
+		if(!vertices.empty())
+		{
+			// Copy the previous vertex first: inserting a range of the vector
+			// into itself is not allowed, since it may be reallocated.
+			GLfloat previous[4];
+			copy(vertices.end() - 4, vertices.end(), previous);
+			vertices.insert(vertices.end(), previous, previous + 4);
+			vertices.insert(vertices.end(), corners, corners + 4);
+		}
+		vertices.insert(vertices.end(), corners, corners + 16);
+	}
+
 	void EnableAttribArrays()
 	{
 		// Connect the xy to the "vert" attribute of the vertex shader.
@@ -82,6 +135,13 @@ void Font::Load(const filesystem::path &imagePath)
 
 	LoadTexture(image);
 	CalculateAdvances(image);
+	{
+		// Any truncations cached for this font may no longer fit.
+		lock_guard<mutex> lock(truncationMutex);
+		truncations.Clear();
+	}
+	// The same goes for any text wrapped with it.
+	WrappedText::ClearCache();
 	SetUpShader(image.Width() / GLYPHS, image.Height());
 	widthEllipses = WidthRawString("...");
 }
@@ -121,29 +181,9 @@ void Font::Draw(const string &str, const Point &point, const Color &color) const
 
 void Font::DrawAliased(const string &str, double x, double y, const Color &color) const
 {
-	glUseProgram(shader->Object());
-	glBindTexture(GL_TEXTURE_2D, texture);
-	if(OpenGL::HasVaoSupport())
-		glBindVertexArray(vao);
-	else
-	{
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
-		EnableAttribArrays();
-	}
-
-	glUniform4fv(colorI, 1, color.Get());
-
-	// Update the scale, only if the screen size has changed.
-	if(Screen::Width() != screenWidth || Screen::Height() != screenHeight)
-	{
-		screenWidth = Screen::Width();
-		screenHeight = Screen::Height();
-		scale[0] = 2.f / screenWidth;
-		scale[1] = -2.f / screenHeight;
-	}
-	glUniform2fv(scaleI, 1, scale);
-	glUniform2f(glyphSizeI, glyphWidth, glyphHeight);
-
+	// Lay out the whole string, including any underlines, as a single triangle
+	// strip, so that it takes one draw call no matter how long it is.
+	vertices.clear();
 	GLfloat textPos[2] = {
 		static_cast<float>(x - 1.),
 		static_cast<float>(y)};
@@ -169,37 +209,53 @@ void Font::DrawAliased(const string &str, double x, double y, const Color &color
 			continue;
 		}
 
-		glUniform1i(glyphI, glyph);
-		glUniform1f(aspectI, 1.f);
-
 		textPos[0] += advance[previous * GLYPHS + glyph] + KERN;
-		glUniform2fv(positionI, 1, textPos);
-
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		AddGlyph(glyph, GLYPHS, textPos[0], textPos[1], glyphWidth, glyphHeight);
 
 		if(underlineChar)
 		{
-			glUniform1i(glyphI, underscoreGlyph);
-			glUniform1f(aspectI, static_cast<float>(advance[glyph * GLYPHS] + KERN)
-				/ (advance[underscoreGlyph * GLYPHS] + KERN));
-
-			glUniform2fv(positionI, 1, textPos);
-
-			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			const float aspect = static_cast<float>(advance[glyph * GLYPHS] + KERN)
+				/ (advance[underscoreGlyph * GLYPHS] + KERN);
+			AddGlyph(underscoreGlyph, GLYPHS, textPos[0], textPos[1], aspect * glyphWidth, glyphHeight);
 			underlineChar = false;
 		}
 
 		previous = glyph;
 	}
+	if(vertices.empty())
+		return;
 
+	glUseProgram(shader->Object());
+	glBindTexture(GL_TEXTURE_2D, texture);
 	if(OpenGL::HasVaoSupport())
-		glBindVertexArray(0);
-	else
+		glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	if(!OpenGL::HasVaoSupport())
+		EnableAttribArrays();
+
+	glUniform4fv(colorI, 1, color.Get());
+
+	// Update the scale, only if the screen size has changed.
+	if(Screen::Width() != screenWidth || Screen::Height() != screenHeight)
+	{
+		screenWidth = Screen::Width();
+		screenHeight = Screen::Height();
+		scale[0] = 2.f / screenWidth;
+		scale[1] = -2.f / screenHeight;
+	}
+	glUniform2fv(scaleI, 1, scale);
+
+	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.size(), vertices.data(), GL_STREAM_DRAW);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, vertices.size() / 4);
+
+	if(!OpenGL::HasVaoSupport())
 	{
 		glDisableVertexAttribArray(vertI);
 		glDisableVertexAttribArray(cornerI);
-		glBindBuffer(GL_ARRAY_BUFFER, vbo);
 	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	if(OpenGL::HasVaoSupport())
+		glBindVertexArray(0);
 	glUseProgram(0);
 }
 
@@ -359,14 +415,6 @@ void Font::SetUpShader(float glyphW, float glyphH)
 		glGenBuffers(1, &vbo);
 		glBindBuffer(GL_ARRAY_BUFFER, vbo);
 
-		GLfloat vertices[] = {
-				0.f, 0.f, 0.f, 0.f,
-				0.f, 1.f, 0.f, 1.f,
-				1.f, 0.f, 1.f, 0.f,
-				1.f, 1.f, 1.f, 1.f
-		};
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
 		if(OpenGL::HasVaoSupport())
 			EnableAttribArrays();
 
@@ -376,10 +424,6 @@ void Font::SetUpShader(float glyphW, float glyphH)
 
 		colorI = shader->Uniform("color");
 		scaleI = shader->Uniform("scale");
-		glyphSizeI = shader->Uniform("glyphSize");
-		glyphI = shader->Uniform("glyph");
-		aspectI = shader->Uniform("aspect");
-		positionI = shader->Uniform("position");
 	}
 
 	// We must update the screen size next time we draw.
@@ -427,19 +471,41 @@ string Font::TruncateText(const DisplayText &text, int &width) const
 	if(layout.width < 0 || (layout.align == Alignment::LEFT && layout.truncate == Truncate::NONE))
 		return str;
 	width = layout.width;
+	if(layout.truncate == Truncate::NONE)
+	{
+		width = WidthRawString(str.c_str());
+		return str;
+	}
+
+	TruncationKey key{this, layout.width, layout.truncate, str};
+	{
+		lock_guard<mutex> lock(truncationMutex);
+		const pair<string, int> *cached = truncations.Get(key);
+		if(cached)
+		{
+			width = cached->second;
+			return cached->first;
+		}
+	}
+
+	string result;
 	switch(layout.truncate)
 	{
-		case Truncate::NONE:
-			width = WidthRawString(str.c_str());
-			return str;
 		case Truncate::FRONT:
-			return TruncateFront(str, width);
+			result = TruncateFront(str, width);
+			break;
 		case Truncate::MIDDLE:
-			return TruncateMiddle(str, width);
+			result = TruncateMiddle(str, width);
+			break;
 		case Truncate::BACK:
 		default:
-			return TruncateBack(str, width);
+			result = TruncateBack(str, width);
+			break;
 	}
+
+	lock_guard<mutex> lock(truncationMutex);
+	truncations.Set(key, make_pair(result, width));
+	return result;
 }
 
 
@@ -17,11 +17,46 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 #include "DisplayText.h"
 #include "Font.h"
+#include "../LruCache.h"
 
 #include <cstring>
+#include <mutex>
 
 using namespace std;
 
+namespace {
+	// Most panels wrap the same text with the same settings every frame, so the
+	// most recent layouts are cached.
+	class LayoutKey {
+	public:
+		const Font *font;
+		int space;
+		int wrapWidth;
+		int tabWidth;
+		int lineHeight;
+		int paragraphBreak;
+		Alignment alignment;
+		string text;
+
+		bool operator==(const LayoutKey &other) const = default;
+
+		class Hash {
+		public:
+			size_t operator()(const LayoutKey &key) const noexcept
+			{
+				size_t seed = hash<string>()(key.text);
+				for(size_t value : {hash<const Font *>()(key.font), static_cast<size_t>(key.wrapWidth),
+						static_cast<size_t>(key.alignment)})
+					seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+				return seed;
+			}
+		};
+	};
+
+	LruCache<LayoutKey, WrappedText, LayoutKey::Hash> layouts(256);
+	mutex layoutMutex;
+}
+
 
 
 WrappedText::WrappedText(const Font &font)
@@ -121,6 +156,32 @@ void WrappedText::SetParagraphBreak(int height)
 
 
 
+// Check whether the given object lays out text exactly like this one.
+bool WrappedText::HasSameFormat(const WrappedText &other) const
+{
+	return font == other.font && space == other.space && wrapWidth == other.wrapWidth
+		&& tabWidth == other.tabWidth && lineHeight == other.lineHeight
+		&& paragraphBreak == other.paragraphBreak && alignment == other.alignment
+		&& truncate == other.truncate;
+}
+
+
+
+// Copy all the formatting parameters, but not the text, of the given object.
+void WrappedText::CopyFormat(const WrappedText &other)
+{
+	font = other.font;
+	space = other.space;
+	wrapWidth = other.wrapWidth;
+	tabWidth = other.tabWidth;
+	lineHeight = other.lineHeight;
+	paragraphBreak = other.paragraphBreak;
+	alignment = other.alignment;
+	truncate = other.truncate;
+}
+
+
+
 // Get the word positions when wrapping the given text. The coordinates
 // always begin at (0, 0).
 void WrappedText::Wrap(const string &str)
@@ -141,6 +202,16 @@ void WrappedText::Wrap(const char *str)
 
 
 
+// Wrap the given text without using the shared cache of recent layouts.
+void WrappedText::WrapUncached(const string &str)
+{
+	SetText(str.data(), str.length());
+
+	Wrap(false);
+}
+
+
+
 /// Get the height of the wrapped text.
 /// With trailingBreak, include a paragraph break after the text.
 int WrappedText::Height(bool trailingBreak) const
@@ -187,6 +258,15 @@ void WrappedText::Draw(const Point &topLeft, const Color &color) const
 
 
 
+// Discard the cached layouts of recently wrapped text.
+void WrappedText::ClearCache()
+{
+	lock_guard<mutex> lock(layoutMutex);
+	layouts.Clear();
+}
+
+
+
 size_t WrappedText::Word::Index() const
 {
 	return index;
@@ -213,7 +293,7 @@ void WrappedText::SetText(const char *it, size_t length)
 
 
 
-void WrappedText::Wrap()
+void WrappedText::Wrap(bool useCache)
 {
 	height = 0;
 	longestLineWidth = 0;
@@ -221,6 +301,21 @@ void WrappedText::Wrap()
 	if(text.empty() || !font)
 		return;
 
+	LayoutKey key{font, space, wrapWidth, tabWidth, lineHeight, paragraphBreak, alignment, text};
+	if(useCache)
+	{
+		lock_guard<mutex> lock(layoutMutex);
+		const WrappedText *cached = layouts.Get(key);
+		if(cached)
+		{
+			text = cached->text;
+			words = cached->words;
+			height = cached->height;
+			longestLineWidth = cached->longestLineWidth;
+			return;
+		}
+	}
+
 	// Do this as a finite state machine.
 	Word word;
 	bool traversingWord = false;
@@ -319,6 +414,12 @@ void WrappedText::Wrap()
 	// We have over-calculated the actual height by an extra paragraph break,
 	// so subtract that.
 	height = max(0, word.y - paragraphBreak);
+
+	if(useCache)
+	{
+		lock_guard<mutex> lock(layoutMutex);
+		layouts.Set(key, *this);
+	}
 }
 
 
@@ -62,9 +62,18 @@ public:
 	int ParagraphBreak() const;
 	void SetParagraphBreak(int height);
 
+	// Check whether the given object lays out text exactly like this one.
+	bool HasSameFormat(const WrappedText &other) const;
+	// Copy all the formatting parameters, but not the text, of the given object.
+	void CopyFormat(const WrappedText &other);
+
 	// Wrap the given text. Use Draw() to draw it.
 	void Wrap(const std::string &str);
 	void Wrap(const char *str);
+	// Wrap the given text without looking it up in, or adding it to, the shared
+	// cache of recent layouts. This is for callers that keep their own layouts,
+	// so they do not evict the ones other panels rely on.
+	void WrapUncached(const std::string &str);
 
 	/// Get the height of the wrapped text.
 	/// With trailingBreak, include a paragraph break after the text.
@@ -76,10 +85,14 @@ public:
 	// Draw the text.
 	void Draw(const Point &topLeft, const Color &color) const;
 
+	// Discard the cached layouts of recently wrapped text, e.g. because the
+	// metrics of a font have changed.
+	static void ClearCache();
+
 
 private:
 	void SetText(const char *it, size_t length);
-	void Wrap();
+	void Wrap(bool useCache = true);
 	void AdjustLine(size_t &lineBegin, int &lineWidth, bool isEnd);
 	int Space(char c) const;
 
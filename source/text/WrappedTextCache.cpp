@@ -0,0 +1,43 @@
+/* WrappedTextCache.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "WrappedTextCache.h"
+
+using namespace std;
+
+
+
+// Get the given text laid out with the formatting of the given object.
+const WrappedText &WrappedTextCache::Get(const string &text, const WrappedText &format)
+{
+	if(!isValid || !layout.HasSameFormat(format))
+	{
+		layout.CopyFormat(format);
+		// This cache holds the only copy of the layout it needs, so don't
+		// evict anyone else's from the shared cache.
+		layout.WrapUncached(text);
+		isValid = true;
+	}
+	return layout;
+}
+
+
+
+// Discard the cached layout.
+void WrappedTextCache::Clear()
+{
+	layout = WrappedText();
+	isValid = false;
+}
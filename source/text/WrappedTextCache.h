@@ -0,0 +1,41 @@
+/* WrappedTextCache.h
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "WrappedText.h"
+
+#include <string>
+
+
+
+// The layout of a piece of text that never changes, e.g. a message that has
+// already been posted. The text is wrapped the first time it is drawn, and is
+// only wrapped again if the formatting it is drawn with changes (for example,
+// because the window was resized), so drawing it every frame is cheap.
+class WrappedTextCache {
+public:
+	// Get the given text laid out with the formatting of the given object. The
+	// text must be the same every time this is called, unless Clear() has been
+	// called in between.
+	const WrappedText &Get(const std::string &text, const WrappedText &format);
+	// Discard the cached layout.
+	void Clear();
+
+
+private:
+	WrappedText layout;
+	bool isValid = false;
+};
@@ -0,0 +1,158 @@
+/* test_mixer.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../../../../source/audio/supplier/effect/Mixer.h"
+
+// ... and any system includes needed for the test file.
+#include <memory>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+// A supplier that provides a given number of chunks of a constant sample value.
+class ConstantSupplier : public AudioSupplier {
+public:
+	ConstantSupplier(sample_t value, size_t chunks) : value(value), chunks(chunks) {}
+
+	size_t MaxChunks() const override { return chunks; }
+	size_t AvailableChunks() const override { return chunks; }
+	std::vector<sample_t> NextDataChunk() override
+	{
+		if(!chunks)
+			return std::vector<sample_t>(Mixer::MIX_CHUNK);
+		--chunks;
+		return std::vector<sample_t>(Mixer::MIX_CHUNK, value);
+	}
+
+
+private:
+	sample_t value;
+	size_t chunks;
+};
+
+std::unique_ptr<AudioSupplier> Constant(AudioSupplier::sample_t value, size_t chunks = 10)
+{
+	return std::make_unique<ConstantSupplier>(value, chunks);
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Mixing sound effects into a single stream", "[Mixer]" ) {
+	GIVEN( "a mixer with no voices" ) {
+		Mixer mixer(4);
+		THEN( "it produces silence forever" ) {
+			const std::vector<AudioSupplier::sample_t> chunk = mixer.NextDataChunk();
+			CHECK( chunk.size() == Mixer::MIX_CHUNK );
+			CHECK( chunk == std::vector<AudioSupplier::sample_t>(Mixer::MIX_CHUNK) );
+			CHECK( mixer.MaxChunks() > 0 );
+			CHECK( mixer.AvailableChunks() > 0 );
+		}
+	}
+	GIVEN( "two centered voices with different gains" ) {
+		Mixer mixer(4);
+		REQUIRE( mixer.AddVoice(Constant(1000), 1., 0.) );
+		REQUIRE( mixer.AddVoice(Constant(1000), .5, 0.) );
+		THEN( "their samples are added together" ) {
+			const std::vector<AudioSupplier::sample_t> chunk = mixer.NextDataChunk();
+			CHECK( chunk.front() == 1500 );
+			CHECK( chunk.back() == 1500 );
+		}
+	}
+	GIVEN( "a voice that is balanced to the right" ) {
+		Mixer mixer(4);
+		REQUIRE( mixer.AddVoice(Constant(1000), 1., 1.) );
+		THEN( "only the right channel plays it" ) {
+			const std::vector<AudioSupplier::sample_t> chunk = mixer.NextDataChunk();
+			CHECK( chunk[0] == 0 );
+			CHECK( chunk[1] == 1000 );
+		}
+	}
+	GIVEN( "voices that add up to more than the sample range" ) {
+		Mixer mixer(4);
+		for(int i = 0; i < 4; ++i)
+			REQUIRE( mixer.AddVoice(Constant(20000), 1., 0.) );
+		THEN( "the mix is clipped" ) {
+			const std::vector<AudioSupplier::sample_t> chunk = mixer.NextDataChunk();
+			CHECK( chunk.front() == 32767 );
+		}
+	}
+	GIVEN( "a voice that runs out of samples" ) {
+		Mixer mixer(4);
+		REQUIRE( mixer.AddVoice(Constant(1000, 1), 1., 0.) );
+		THEN( "it is removed once it has been mixed" ) {
+			CHECK( mixer.NextDataChunk().front() == 1000 );
+			CHECK( mixer.VoiceCount() == 0 );
+			CHECK( mixer.NextDataChunk().front() == 0 );
+		}
+	}
+	GIVEN( "a voice that is stopped" ) {
+		Mixer mixer(4);
+		const uint64_t id = mixer.AddVoice(Constant(1000), 1., 0.);
+		REQUIRE( id );
+		mixer.StopVoice(id);
+		THEN( "it fades out over one chunk and is removed" ) {
+			const std::vector<AudioSupplier::sample_t> chunk = mixer.NextDataChunk();
+			CHECK( chunk.front() == 1000 );
+			CHECK( chunk.back() < 10 );
+			CHECK_FALSE( mixer.SetVoice(id, 1., 0.) );
+			CHECK( mixer.NextDataChunk().front() == 0 );
+		}
+	}
+}
+
+SCENARIO( "Limiting the number of mixed voices", "[Mixer]" ) {
+	GIVEN( "a mixer with room for two voices" ) {
+		Mixer mixer(2);
+		const uint64_t loud = mixer.AddVoice(Constant(1000), .5, 0.);
+		const uint64_t quiet = mixer.AddVoice(Constant(1000), .25, 0.);
+		REQUIRE( loud );
+		REQUIRE( quiet );
+		REQUIRE( mixer.VoiceCount() == 2 );
+
+		WHEN( "a louder voice is added" ) {
+			const uint64_t louder = mixer.AddVoice(Constant(1000), .75, 0.);
+			THEN( "it replaces the quietest voice" ) {
+				CHECK( louder );
+				CHECK( mixer.VoiceCount() == 2 );
+				CHECK_FALSE( mixer.SetVoice(quiet, .25, 0.) );
+				CHECK( mixer.SetVoice(loud, .5, 0.) );
+			}
+		}
+		WHEN( "a quieter voice is added" ) {
+			THEN( "it is culled" ) {
+				CHECK_FALSE( mixer.AddVoice(Constant(1000), .1, 0.) );
+				CHECK( mixer.VoiceCount() == 2 );
+			}
+		}
+		WHEN( "an almost inaudible voice is added" ) {
+			Mixer empty(2);
+			THEN( "it is culled even if there is room for it" ) {
+				CHECK_FALSE( empty.AddVoice(Constant(1000), Mixer::MIN_GAIN / 2., 0.) );
+				CHECK( empty.VoiceCount() == 0 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
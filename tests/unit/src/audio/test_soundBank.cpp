@@ -0,0 +1,200 @@
+/* test_soundBank.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../../source/audio/SoundBank.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../../source/audio/Sound.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+
+// Write the given samples as a 16-bit mono WAV file.
+void WriteWav(const std::filesystem::path &path, const std::vector<int16_t> &samples)
+{
+	std::ofstream out(path, std::ios::binary);
+	auto write = [&out](uint32_t value, int bytes)
+	{
+		for(int i = 0; i < bytes; ++i)
+			out.put(static_cast<char>(value >> (8 * i)));
+	};
+	const uint32_t size = static_cast<uint32_t>(samples.size() * 2);
+	out << "RIFF";
+	write(36 + size, 4);
+	out << "WAVEfmt ";
+	write(16, 4);
+	write(1, 2);
+	write(1, 2);
+	write(44100, 4);
+	write(88200, 4);
+	write(2, 2);
+	write(16, 2);
+	out << "data";
+	write(size, 4);
+	for(int16_t sample : samples)
+		write(static_cast<uint16_t>(sample), 2);
+}
+
+std::vector<int16_t> Ramp(size_t count, int step)
+{
+	std::vector<int16_t> samples(count);
+	for(size_t i = 0; i < count; ++i)
+		samples[i] = static_cast<int16_t>(static_cast<int>(i) * step);
+	return samples;
+}
+
+// A resource folder with a few sounds in it, removed again afterwards.
+class SoundFolder {
+public:
+	SoundFolder()
+		: path(std::filesystem::temp_directory_path() / "es-test-sound-bank")
+	{
+		std::filesystem::remove_all(path);
+		std::filesystem::create_directories(path / "sounds" / "sub");
+		WriteWav(path / "sounds" / "a.wav", Ramp(10000, 1));
+		WriteWav(path / "sounds" / "a@3x.wav", Ramp(3000, -1));
+		WriteWav(path / "sounds" / "sub" / "b~.wav", Ramp(777, 3));
+	}
+	~SoundFolder()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(path, error);
+	}
+
+	const std::filesystem::path path;
+};
+
+// Overwrite the bytes at the given position of a file.
+void Patch(const std::filesystem::path &path, std::streamoff position, const std::string &bytes)
+{
+	std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+	file.seekp(position);
+	file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "building and opening a sound bank", "[SoundBank]" ) {
+	GIVEN( "a folder of sounds" ) {
+		SoundFolder folder;
+		WHEN( "a bank is built from it" ) {
+			REQUIRE( SoundBank::Build(folder.path) );
+			THEN( "no temporary file is left behind" ) {
+				CHECK( std::filesystem::exists(SoundBank::BankPath(folder.path)) );
+				CHECK_FALSE( std::filesystem::exists(folder.path / "sounds.bank.tmp") );
+			}
+			THEN( "opening it gives back every sound exactly" ) {
+				SoundBank bank;
+				REQUIRE( bank.Open(folder.path) );
+				const auto &entries = bank.Entries();
+				REQUIRE( entries.size() == 2 );
+				REQUIRE( entries.contains("a") );
+				REQUIRE( entries.contains("sub/b") );
+
+				const SoundBank::Entry &a = entries.at("a");
+				CHECK_FALSE( a.isLooping );
+				CHECK( std::vector<int16_t>(a.buffer.begin(), a.buffer.end()) == Ramp(10000, 1) );
+				CHECK( std::vector<int16_t>(a.buffer3x.begin(), a.buffer3x.end()) == Ramp(3000, -1) );
+
+				const SoundBank::Entry &b = entries.at("sub/b");
+				CHECK( b.isLooping );
+				CHECK( std::vector<int16_t>(b.buffer.begin(), b.buffer.end()) == Ramp(777, 3) );
+				// A sound without a 3x version uses its regular samples for both.
+				CHECK( b.buffer3x.data() == b.buffer.data() );
+			}
+		}
+		WHEN( "there is no bank" ) {
+			SoundBank bank;
+			THEN( "it cannot be opened" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+	}
+}
+
+SCENARIO( "opening a damaged sound bank", "[SoundBank]" ) {
+	GIVEN( "a bank that has been built" ) {
+		SoundFolder folder;
+		REQUIRE( SoundBank::Build(folder.path) );
+		const std::filesystem::path path = SoundBank::BankPath(folder.path);
+		const auto size = std::filesystem::file_size(path);
+		SoundBank bank;
+
+		WHEN( "its magic string is wrong" ) {
+			Patch(path, 0, "NOTABANK");
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+		WHEN( "it is cut off in the middle of the index" ) {
+			std::filesystem::resize_file(path, 20);
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+		WHEN( "it is cut off in the middle of the samples" ) {
+			std::filesystem::resize_file(path, size - 100);
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+		WHEN( "it claims to have more sounds than it does" ) {
+			Patch(path, 8, std::string(4, '\x7f'));
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+		WHEN( "a name is longer than the file" ) {
+			Patch(path, 12, std::string(4, '\xff'));
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+		WHEN( "the samples of a sound lie outside of the file" ) {
+			// The first sound is "a": after the magic string, the count, the
+			// length of its name, its name and its flags comes its offset.
+			Patch(path, 8 + 4 + 4 + 1 + 4, std::string(7, '\0') + '\x01');
+			THEN( "it is rejected" ) {
+				CHECK_FALSE( bank.Open(folder.path) );
+				CHECK( bank.Entries().empty() );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -191,6 +191,34 @@ SCENARIO( "Witness ratio calculation" , "[ActionLog][WitnessRatio]" ) {
 		}
 	}
 }
+
+SCENARIO( "ActionLog queries only count the records in range" , "[ActionLog][Query]" ) {
+	GIVEN( "an action log that has trimmed its oldest record" ) {
+		ActionLog log(3);
+		Date day1(1, 1, 3014);
+		Date day2(2, 1, 3014);
+		Date day3(3, 1, 3014);
+
+		log.Record(day1, ShipEvent::DESTROY, nullptr, "System A", 5, 1000, true);
+		log.Record(day2, ShipEvent::DISABLE, nullptr, "System B", 3, 500, false);
+		log.Record(day3, ShipEvent::DESTROY, nullptr, "System C", 2, 200, true);
+		log.Record(day3, ShipEvent::ASSIST, nullptr, "System D", 0, 0, true);
+		REQUIRE( log.Size() == 3 );
+
+		THEN( "the trimmed record is not counted" ) {
+			CHECK( log.CountEventType(ShipEvent::DESTROY, day3, 30) == 1 );
+			CHECK( log.GetCrewKilledAgainst(nullptr, day3, 30) == 5 );
+			CHECK( log.GetValueDestroyedAgainst(nullptr, day3, 30) == 700 );
+			CHECK( log.GetWitnessedRatio(day3, 30) == Catch::Approx(2. / 3.) );
+		}
+		THEN( "records outside of the date range are not counted" ) {
+			CHECK( log.GetCrewKilledAgainst(nullptr, day3, 0) == 2 );
+			CHECK( log.GetCrewKilledAgainst(nullptr, day2, 30) == 3 );
+			CHECK( log.CountEventType(ShipEvent::DESTROY | ShipEvent::DISABLE, day2, 30) == 1 );
+			CHECK( log.GetActionsAgainst(nullptr, day3, 0).size() == 2 );
+		}
+	}
+}
 // #endregion unit tests
 
 
@@ -20,6 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 // Include a helper functions.
 #include "datanode-factory.h"
+#include "../../../source/DataWriter.h"
 #include "../../../source/text/Format.h"
 #include "logger-output.h"
 #include "output-capture.hpp"
@@ -289,6 +290,68 @@ now with
 		}
 	}
 }
+
+SCENARIO( "Loading a DataFile in the binary encoding", "[DataFile]" ) {
+	GIVEN( "Data written by a binary DataWriter" ) {
+		DataWriter writer;
+		writer.SetBinary();
+		writer.Write("node1");
+		writer.BeginChild();
+		{
+			writer.Write("foo", 12.5);
+			writer.WriteComment("not stored");
+			writer.Write("quoted \"token\"", "node1", "");
+		}
+		writer.EndChild();
+		writer.Write("node2", -3);
+		const std::string data = writer.SaveToString();
+		REQUIRE( DataFile::IsBinary(data) );
+
+		std::istringstream stream(data);
+		const DataFile root(stream);
+
+		THEN( "the same nodes are read back" ) {
+			REQUIRE( std::distance(root.begin(), root.end()) == 2 );
+			const DataNode &first = *root.begin();
+			CHECK( first.Token(0) == "node1" );
+			REQUIRE( std::distance(first.begin(), first.end()) == 2 );
+			CHECK( first.begin()->Token(0) == "foo" );
+			CHECK( first.begin()->Value(1) == 12.5 );
+			const DataNode &quoted = *std::next(first.begin());
+			REQUIRE( quoted.Size() == 3 );
+			CHECK( quoted.Token(0) == "quoted \"token\"" );
+			CHECK( quoted.Token(1) == "node1" );
+			CHECK( quoted.Token(2).empty() );
+			const DataNode &second = *std::next(root.begin());
+			CHECK( second.Token(0) == "node2" );
+			CHECK( second.Value(1) == -3 );
+		}
+		THEN( "converting it to text gives the same result as writing text directly" ) {
+			DataWriter text;
+			for(const DataNode &node : root)
+				text.Write(node);
+			CHECK( text.SaveToString() == "node1\n\tfoo 12.5\n\t`quoted \"token\"` node1 \"\"\nnode2 -3\n" );
+		}
+	}
+
+	GIVEN( "Truncated binary data" ) {
+		OutputSink sink(std::cerr);
+		DataWriter writer;
+		writer.SetBinary();
+		writer.Write("a", "long enough token");
+		std::string data = writer.SaveToString();
+		data.resize(data.size() - 4);
+
+		std::istringstream stream(data);
+		const DataFile root(stream);
+
+		THEN( "a warning is issued" ) {
+			const auto warnings = Split(IgnoreLogHeaders(sink.Flush()));
+			REQUIRE( !warnings.empty() );
+			CHECK( warnings[0].find("malformed binary data") != std::string::npos );
+		}
+	}
+}
 // #endregion unit tests
 
 
@@ -20,6 +20,7 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 
 // Include other necessary headers.
 #include "../../../source/Date.h"
+#include "../../../source/EsUuid.h"
 #include "../../../source/ShipEvent.h"
 
 
@@ -209,6 +210,42 @@ SCENARIO( "EncounterLog management" , "[EncounterLog][Management]" ) {
 		}
 	}
 }
+
+SCENARIO( "EncounterLog keeps the most recently seen records" , "[EncounterLog][Trim]" ) {
+	GIVEN( "a full encounter log" ) {
+		EncounterLog log(2);
+		const EsUuid first;
+		const EsUuid second;
+		log.GetOrCreate(first, Date(1, 1, 3014), "Sol");
+		log.GetOrCreate(second.ToString(), Date(2, 1, 3014), "Sol");
+		REQUIRE( log.Size() == 2 );
+
+		THEN( "records can be found by either their UUID or its text" ) {
+			REQUIRE( log.Get(first) == log.Get(first.ToString()) );
+			REQUIRE( log.Get(second) != nullptr );
+			REQUIRE( log.Get(second)->npcUuid == second.ToString() );
+		}
+
+		WHEN( "the oldest NPC is seen again before a new one is met" ) {
+			log.GetOrCreate(first, Date(3, 1, 3014), "Sol");
+			log.GetOrCreate("uuid-123", Date(4, 1, 3014), "Sol");
+			THEN( "the least recently seen record is removed" ) {
+				REQUIRE( log.Size() == 2 );
+				REQUIRE( log.Get(first) != nullptr );
+				REQUIRE( log.Get(second) == nullptr );
+				REQUIRE( log.HasRecord("uuid-123") );
+			}
+		}
+
+		WHEN( "the maximum size is reduced" ) {
+			log.SetMaxRecords(1);
+			THEN( "only the most recently seen record remains" ) {
+				REQUIRE( log.Size() == 1 );
+				REQUIRE( log.Get(second) != nullptr );
+			}
+		}
+	}
+}
 // #endregion unit tests
 
 
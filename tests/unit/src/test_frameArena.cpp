@@ -0,0 +1,78 @@
+/* test_frameArena.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/FrameArena.h"
+
+// ... and any system includes needed for the test file.
+#include <memory_resource>
+#include <vector>
+
+namespace { // test namespace
+
+// #region unit tests
+SCENARIO( "getting memory outside of a frame", "[FrameArena]" ) {
+	GIVEN( "no open frame" ) {
+		THEN( "the default memory resource is used" ) {
+			CHECK( FrameArena::Resource() == std::pmr::get_default_resource() );
+		}
+	}
+}
+
+SCENARIO( "getting memory inside of a frame", "[FrameArena]" ) {
+	GIVEN( "an open frame" ) {
+		auto fill = [] {
+			FrameArena::Frame frame;
+			std::pmr::vector<int> values(FrameArena::Resource());
+			for(int i = 0; i < 1000; ++i)
+				values.push_back(i);
+			return values.size();
+		};
+		WHEN( "containers allocate from it" ) {
+			{
+				FrameArena::Frame frame;
+				CHECK( FrameArena::Resource() != std::pmr::get_default_resource() );
+				{
+					FrameArena::Frame nested;
+					CHECK( FrameArena::Resource() != std::pmr::get_default_resource() );
+				}
+				CHECK( FrameArena::Resource() != std::pmr::get_default_resource() );
+			}
+			THEN( "closing the outermost frame falls back to the default resource" ) {
+				CHECK( FrameArena::Resource() == std::pmr::get_default_resource() );
+			}
+			fill();
+			THEN( "every allocation is counted" ) {
+				CHECK( FrameArena::Allocations() > 0 );
+			}
+		}
+		WHEN( "the same work is done again" ) {
+			fill();
+			fill();
+			THEN( "it is served without going to the heap" ) {
+				CHECK( FrameArena::Allocations() > 0 );
+				CHECK( FrameArena::HeapAllocations() == 0 );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,106 @@
+/* test_information.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/Information.h"
+
+// ... and any system includes needed for the test file.
+#include <string>
+
+namespace { // test namespace
+
+// #region unit tests
+SCENARIO( "Information values can be looked up by name or by key", "[Information]" ) {
+	GIVEN( "an empty Information object" ) {
+		Information info;
+		const Information::Key key("test string");
+
+		THEN( "unset values report their defaults" ) {
+			CHECK( info.GetString(key).empty() );
+			CHECK( info.BarValue("test bar") == 0. );
+			CHECK( info.BarSegments("test bar") == 1. );
+			CHECK( info.GetSpriteFrame("test sprite") == 0.f );
+			CHECK( info.GetSpriteUnit("test sprite").Y() == -1. );
+			CHECK( info.GetSwizzle("test sprite") == nullptr );
+			CHECK_FALSE( info.HasCondition("test condition") );
+		}
+
+		WHEN( "values are set by name" ) {
+			info.SetString("test string", "value");
+			info.SetBar("test bar", .5, 4.);
+			info.SetCondition("test condition");
+			THEN( "keys for the same names find them" ) {
+				CHECK( info.GetString(key) == "value" );
+				CHECK( info.BarValue(Information::Key("test bar")) == .5 );
+				CHECK( info.BarSegments(Information::Key("test bar")) == 4. );
+				CHECK( info.HasCondition(Information::Key::Condition("test condition")) );
+			}
+			THEN( "values stored under other names are unaffected" ) {
+				CHECK( info.GetString("test bar").empty() );
+				CHECK( info.BarValue("test string") == 0. );
+				CHECK_FALSE( info.HasCondition("test string") );
+			}
+
+			AND_WHEN( "the object is cleared" ) {
+				info.Clear();
+				THEN( "every value is unset again" ) {
+					CHECK( info.GetString(key).empty() );
+					CHECK( info.BarSegments("test bar") == 1. );
+					CHECK_FALSE( info.HasCondition("test condition") );
+				}
+			}
+		}
+
+		WHEN( "a value is set by key" ) {
+			info.SetString(key, "value");
+			THEN( "it can be found by name" ) {
+				CHECK( info.GetString("test string") == "value" );
+			}
+		}
+	}
+}
+
+SCENARIO( "Information conditions can be negated", "[Information]" ) {
+	GIVEN( "an Information object with one condition" ) {
+		Information info;
+		info.SetCondition("test set");
+
+		THEN( "an empty condition is always true" ) {
+			CHECK( info.HasCondition("") );
+			CHECK( info.HasCondition(Information::Key::Condition("")) );
+			CHECK_FALSE( info.HasCondition("!") );
+		}
+		THEN( "a '!' prefix negates the condition" ) {
+			CHECK( info.HasCondition("test set") );
+			CHECK_FALSE( info.HasCondition("!test set") );
+			CHECK( info.HasCondition("!!test set") );
+			CHECK_FALSE( info.HasCondition("test unset") );
+			CHECK( info.HasCondition("!test unset") );
+		}
+		THEN( "a default key refers to no value" ) {
+			const Information::Key key;
+			CHECK( key.IsEmpty() );
+			CHECK( info.HasCondition(key) );
+			CHECK( info.GetString(key).empty() );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,83 @@
+/* test_lruCache.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/LruCache.h"
+
+// ... and any system includes needed for the test file.
+#include <string>
+
+namespace { // test namespace
+
+// #region unit tests
+SCENARIO( "an LruCache keeps the most recently used entries", "[LruCache]" ) {
+	GIVEN( "a full cache with room for two entries" ) {
+		LruCache<std::string, int> cache(2);
+		cache.Set("a", 1);
+		cache.Set("b", 2);
+		REQUIRE( cache.size() == 2 );
+
+		THEN( "both entries can be found" ) {
+			REQUIRE( cache.Get("a") != nullptr );
+			CHECK( *cache.Get("a") == 1 );
+			REQUIRE( cache.Get("b") != nullptr );
+			CHECK( *cache.Get("b") == 2 );
+			CHECK( cache.Get("c") == nullptr );
+		}
+
+		WHEN( "a new entry is added" ) {
+			cache.Set("c", 3);
+			THEN( "the least recently used entry is evicted" ) {
+				CHECK( cache.size() == 2 );
+				CHECK( cache.Get("a") == nullptr );
+				CHECK( cache.Get("b") != nullptr );
+				CHECK( cache.Get("c") != nullptr );
+			}
+		}
+
+		WHEN( "the oldest entry is used before a new entry is added" ) {
+			cache.Get("a");
+			cache.Set("c", 3);
+			THEN( "the entry that was used is kept" ) {
+				CHECK( cache.Get("a") != nullptr );
+				CHECK( cache.Get("b") == nullptr );
+			}
+		}
+
+		WHEN( "an existing entry is replaced" ) {
+			cache.Set("a", 10);
+			THEN( "the cache does not grow" ) {
+				CHECK( cache.size() == 2 );
+				REQUIRE( cache.Get("a") != nullptr );
+				CHECK( *cache.Get("a") == 10 );
+			}
+		}
+
+		WHEN( "the cache is cleared" ) {
+			cache.Clear();
+			THEN( "it is empty" ) {
+				CHECK( cache.empty() );
+				CHECK( cache.Get("a") == nullptr );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
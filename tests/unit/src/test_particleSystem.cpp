@@ -0,0 +1,82 @@
+/* test_particleSystem.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include a helper for creating well-formed DataNodes.
+#include "datanode-factory.h"
+
+// Include only the tested class's header.
+#include "../../../source/ParticleSystem.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/Effect.h"
+
+#include <vector>
+
+namespace { // test namespace
+
+// #region mock data
+Effect MakeEffect(int lifetime)
+{
+	Effect effect;
+	effect.Load(AsDataNode("effect test\n\tlifetime " + std::to_string(lifetime)));
+	return effect;
+}
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "Visuals are stepped and expired by a ParticleSystem", "[ParticleSystem]" ) {
+	GIVEN( "an empty particle system" ) {
+		ParticleSystem particles;
+		REQUIRE( particles.IsEmpty() );
+
+		WHEN( "visuals with different lifetimes are appended" ) {
+			const Effect shortLived = MakeEffect(1);
+			const Effect longLived = MakeEffect(3);
+			std::vector<Visual> added;
+			added.emplace_back(shortLived, Point(), Point(1., 0.), Angle());
+			added.emplace_back(longLived, Point(), Point(0., 1.), Angle());
+			added.emplace_back(shortLived, Point(), Point(), Angle());
+			particles.Append(added);
+
+			THEN( "the system takes all of them" ) {
+				CHECK( added.empty() );
+				CHECK( particles.Size() == 3 );
+			}
+			THEN( "each visual lasts one step longer than its lifetime" ) {
+				particles.Move();
+				CHECK( particles.Size() == 3 );
+				particles.Move();
+				CHECK( particles.Size() == 1 );
+				particles.Move();
+				CHECK( particles.Size() == 1 );
+				particles.Move();
+				CHECK( particles.IsEmpty() );
+			}
+			THEN( "clearing removes every visual" ) {
+				particles.Clear();
+				CHECK( particles.IsEmpty() );
+			}
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
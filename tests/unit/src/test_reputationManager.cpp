@@ -21,6 +21,9 @@ this program. If not, see <https://www.gnu.org/licenses/>.
 // Include other necessary headers.
 #include "../../../source/Date.h"
 
+#include <cmath>
+#include <vector>
+
 
 
 namespace { // test namespace
@@ -261,12 +264,111 @@ SCENARIO( "Event history trimming" , "[ReputationManager][Trim]" ) {
 			state.RecordEvent(event);
 		}
 
-		REQUIRE( state.recentEvents.size() == 100 );
+		THEN( "only the most recent events are kept" ) {
+			REQUIRE( state.recentEvents.size() == ReputationEventHistory::CAPACITY );
+			REQUIRE( state.recentEvents[0].reason == "event 50" );
+			REQUIRE( state.recentEvents[49].reason == "event 99" );
+		}
+
+		WHEN( "history is trimmed to 20" ) {
+			state.TrimEventHistory(20);
+			THEN( "only the 20 most recent events should remain" ) {
+				REQUIRE( state.recentEvents.size() == 20 );
+				REQUIRE( state.recentEvents[0].reason == "event 80" );
+				REQUIRE( state.recentEvents[19].reason == "event 99" );
+			}
+		}
+	}
+}
+
+SCENARIO( "Reputation decays over many days at once" , "[ReputationManager][Decay]" ) {
+	GIVEN( "two managers tracking the same government" ) {
+		const Date start(1, 1, 3014);
+		ReputationManager daily;
+		ReputationManager lazy;
+		daily.SetDate(start);
+		lazy.SetDate(start);
+		daily.GetOrCreateState(nullptr);
+		lazy.GetOrCreateState(nullptr);
+
+		WHEN( "one is updated every day and the other only at the end" ) {
+			const double initial = GENERATE( 60., -60. );
+			double dailyRep = initial;
+			std::vector<ThresholdCrossing> dailyCrossings;
+			for(int day = 1; day <= 200; ++day)
+			{
+				daily.SetDate(start + day);
+				for(const ThresholdCrossing &crossing : daily.Update(nullptr, dailyRep))
+					dailyCrossings.push_back(crossing);
+			}
+
+			lazy.SetDate(start + 200);
+			double lazyRep = initial;
+			const double projected = lazy.CurrentReputation(nullptr, lazyRep);
+			std::vector<ThresholdCrossing> lazyCrossings = lazy.Update(nullptr, lazyRep);
+
+			THEN( "both reach the same reputation" ) {
+				CHECK( lazyRep == Catch::Approx(dailyRep) );
+				CHECK( projected == lazyRep );
+				CHECK( std::abs(lazyRep) < std::abs(initial) );
+			}
+			THEN( "both cross the same thresholds on the same days" ) {
+				REQUIRE( lazyCrossings.size() == dailyCrossings.size() );
+				REQUIRE_FALSE( lazyCrossings.empty() );
+				for(size_t i = 0; i < lazyCrossings.size(); ++i)
+				{
+					CHECK( lazyCrossings[i].date == dailyCrossings[i].date );
+					CHECK( lazyCrossings[i].fromThreshold == dailyCrossings[i].fromThreshold );
+					CHECK( lazyCrossings[i].toThreshold == dailyCrossings[i].toThreshold );
+				}
+			}
+			THEN( "the days since a positive interaction are brought up to date" ) {
+				CHECK( lazy.GetState(nullptr)->daysSincePositiveInteraction == 200 );
+			}
+		}
+
+		WHEN( "the decay is applied without looking for threshold crossings" ) {
+			lazy.SetDate(start + 200);
+			daily.SetDate(start + 200);
+			double appliedRep = 60.;
+			double updatedRep = 60.;
+			lazy.ApplyDecay(nullptr, appliedRep);
+			daily.Update(nullptr, updatedRep);
+
+			THEN( "it reaches the same reputation and state as a full update" ) {
+				CHECK( appliedRep == updatedRep );
+				CHECK( lazy.GetState(nullptr)->lastDecay == daily.GetState(nullptr)->lastDecay );
+				CHECK( lazy.GetState(nullptr)->daysSincePositiveInteraction == 200 );
+			}
+			THEN( "no further decay is pending" ) {
+				CHECK( lazy.CurrentReputation(nullptr, appliedRep) == appliedRep );
+			}
+		}
+	}
+}
+
+SCENARIO( "Reputation decay starts when the date is first known" , "[ReputationManager][Decay]" ) {
+	GIVEN( "a government that was tracked before the date was set" ) {
+		const Date start(1, 1, 3014);
+		ReputationManager manager;
+		manager.GetOrCreateState(nullptr);
+		REQUIRE_FALSE( manager.GetState(nullptr)->lastDecay );
 
-		WHEN( "history is trimmed to 50" ) {
-			state.TrimEventHistory(50);
-			THEN( "only 50 events should remain" ) {
-				REQUIRE( state.recentEvents.size() == 50 );
+		WHEN( "the date is set" ) {
+			manager.SetDate(start);
+			THEN( "decay starts from that date" ) {
+				CHECK( manager.GetState(nullptr)->lastDecay == start );
+			}
+		}
+		WHEN( "days pass before the reputation is read" ) {
+			manager.SetDate(start);
+			manager.SetDate(start + 100);
+			const double projected = manager.CurrentReputation(nullptr, 60.);
+			double updated = 60.;
+			manager.Update(nullptr, updated);
+			THEN( "reading it includes the pending decay, just like updating it" ) {
+				CHECK( projected < 60. );
+				CHECK( projected == updated );
 			}
 		}
 	}
@@ -0,0 +1,187 @@
+/* test_saveJournal.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/SaveJournal.h"
+
+// ... and any system includes needed for the test file.
+#include "../../../source/SaveQueue.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace { // test namespace
+
+// #region mock data
+
+// A saved game, with a section that never changes, so that the journal stays
+// smaller than the snapshot.
+std::string Contents(const std::string &ships, const std::string &credits)
+{
+	std::string contents = "# section: pilot\n"
+		"pilot Test Pilot\n"
+		"# section: ships\n"
+		"ship Shuttle\n"
+		"\tname " + ships + "\n"
+		"# section: property\n"
+		"account\n"
+		"\tcredits " + credits + "\n"
+		"# section: visited\n";
+	for(int i = 0; i < 100; ++i)
+		contents += "visited \"System " + std::to_string(i) + "\"\n";
+	return contents;
+}
+
+std::string ReadFile(const std::filesystem::path &path)
+{
+	std::ifstream in(path, std::ios::binary);
+	std::ostringstream out;
+	out << in.rdbuf();
+	return out.str();
+}
+
+// A directory of its own for the files of each test, removed again afterwards.
+class TemporaryDirectory {
+public:
+	TemporaryDirectory()
+		: path(std::filesystem::temp_directory_path() / "es-test-save-journal")
+	{
+		std::filesystem::remove_all(path);
+		std::filesystem::create_directories(path);
+	}
+	~TemporaryDirectory()
+	{
+		std::error_code error;
+		std::filesystem::remove_all(path, error);
+	}
+
+	const std::filesystem::path path;
+};
+
+// #endregion mock data
+
+
+
+// #region unit tests
+SCENARIO( "saving a game with a journal", "[SaveJournal]" ) {
+	TemporaryDirectory directory;
+	const std::filesystem::path save = directory.path / "Test Pilot.txt";
+	const std::filesystem::path journal = directory.path / "Test Pilot.txt.journal";
+
+	GIVEN( "a game that has been saved once" ) {
+		SaveJournal::Write(save, Contents("Alpha", "1000"));
+		SaveQueue::Wait();
+		const std::string snapshot = ReadFile(save);
+		THEN( "it is written as a complete snapshot" ) {
+			CHECK_FALSE( SaveJournal::HasJournal(save) );
+			CHECK( SaveJournal::Read(save).ends_with(Contents("Alpha", "1000")) );
+		}
+
+		WHEN( "only one section changes before the next save" ) {
+			SaveJournal::Write(save, Contents("Alpha", "2500"));
+			SaveQueue::Wait();
+			THEN( "only that section is added to the journal" ) {
+				CHECK( ReadFile(save) == snapshot );
+				REQUIRE( SaveJournal::HasJournal(save) );
+				const std::string record = ReadFile(journal);
+				CHECK( record.find("credits 2500") != std::string::npos );
+				CHECK( record.find("Alpha") == std::string::npos );
+			}
+			THEN( "reading it gives the new contents" ) {
+				CHECK( SaveJournal::Read(save) == Contents("Alpha", "2500") );
+			}
+		}
+		WHEN( "nothing changes before the next save" ) {
+			SaveJournal::Write(save, Contents("Alpha", "1000"));
+			SaveQueue::Wait();
+			THEN( "nothing is written" ) {
+				CHECK( ReadFile(save) == snapshot );
+				CHECK_FALSE( SaveJournal::HasJournal(save) );
+			}
+		}
+		WHEN( "the game is saved several times" ) {
+			SaveJournal::Write(save, Contents("Alpha", "2500"));
+			SaveJournal::Write(save, Contents("Beta", "2500"));
+			SaveJournal::Write(save, Contents("Beta", "3000"));
+			SaveQueue::Wait();
+			THEN( "every change is applied in order" ) {
+				CHECK( SaveJournal::Read(save) == Contents("Beta", "3000") );
+			}
+			AND_WHEN( "the journal is compacted" ) {
+				SaveJournal::Compact(save);
+				SaveQueue::Wait();
+				THEN( "the snapshot holds every change and the journal is gone" ) {
+					CHECK_FALSE( SaveJournal::HasJournal(save) );
+					CHECK( SaveJournal::Read(save).ends_with(Contents("Beta", "3000")) );
+				}
+			}
+			AND_WHEN( "the save is copied" ) {
+				const std::filesystem::path copy = directory.path / "Test Pilot~copy.txt";
+				REQUIRE( SaveJournal::Copy(save, copy) );
+				THEN( "the copy is a complete snapshot" ) {
+					CHECK_FALSE( SaveJournal::HasJournal(copy) );
+					CHECK( ReadFile(copy) == Contents("Beta", "3000") );
+				}
+			}
+			AND_WHEN( "the save is deleted" ) {
+				SaveJournal::Delete(save);
+				THEN( "its journal is deleted too" ) {
+					CHECK_FALSE( std::filesystem::exists(save) );
+					CHECK_FALSE( SaveJournal::HasJournal(save) );
+				}
+			}
+		}
+		WHEN( "the last record in the journal was cut off" ) {
+			SaveJournal::Write(save, Contents("Alpha", "2500"));
+			SaveQueue::Wait();
+			{
+				std::ofstream out(journal, std::ios::app | std::ios::binary);
+				out << "# record\n# section: ships\nship Shuttle\n";
+			}
+			THEN( "it is ignored" ) {
+				CHECK( SaveJournal::Read(save) == Contents("Alpha", "2500") );
+			}
+		}
+		WHEN( "the journal belongs to a different snapshot" ) {
+			{
+				std::ofstream out(journal, std::ios::binary);
+				out << "# journal 0-0\n# record\n# section: ships\nship Shuttle\n\tname Gamma\n# end record\n";
+			}
+			THEN( "it is ignored" ) {
+				CHECK( SaveJournal::Read(save).ends_with(Contents("Alpha", "1000")) );
+			}
+		}
+	}
+	GIVEN( "a game that is not divided into sections" ) {
+		const std::string contents = "pilot Test Pilot\ndate 1 1 3000\n";
+		SaveJournal::Write(save, contents);
+		SaveJournal::Write(save, contents);
+		SaveQueue::Wait();
+		THEN( "it is always written in full" ) {
+			CHECK_FALSE( SaveJournal::HasJournal(save) );
+			CHECK( ReadFile(save) == contents );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -0,0 +1,148 @@
+/* test_slotMap.cpp
+Copyright (c) 2025 by the Godel's Sky contributors
+
+Endless Sky is free software: you can redistribute it and/or modify it under the
+terms of the GNU General Public License as published by the Free Software
+Foundation, either version 3 of the License, or (at your option) any later version.
+
+Endless Sky is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "es-test.hpp"
+
+// Include only the tested class's header.
+#include "../../../source/SlotMap.h"
+
+// ... and any system includes needed for the test file.
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace { // test namespace
+
+// #region unit tests
+SCENARIO( "a default handle refers to nothing", "[SlotMap]" ) {
+	GIVEN( "a null handle" ) {
+		const SlotHandle handle;
+		THEN( "it is null" ) {
+			CHECK( handle.IsNull() );
+		}
+		THEN( "no map contains it" ) {
+			SlotMap<int> map;
+			map.Insert(1);
+			CHECK_FALSE( map.Contains(handle) );
+			CHECK( map.Get(handle) == nullptr );
+		}
+	}
+}
+
+SCENARIO( "objects can be inserted into and erased from a SlotMap", "[SlotMap]" ) {
+	GIVEN( "a map with three objects" ) {
+		SlotMap<std::string> map;
+		const SlotHandle a = map.Insert("a");
+		const SlotHandle b = map.Insert("b");
+		const SlotHandle c = map.Insert("c");
+		REQUIRE( map.size() == 3 );
+
+		THEN( "every handle is valid and distinct" ) {
+			CHECK_FALSE( a.IsNull() );
+			CHECK( map.Contains(a) );
+			CHECK( map.Contains(b) );
+			CHECK( map.Contains(c) );
+			CHECK_FALSE( a == b );
+			CHECK_FALSE( b == c );
+		}
+		THEN( "each handle returns its own object" ) {
+			CHECK( *map.Get(a) == "a" );
+			CHECK( *map.Get(b) == "b" );
+			CHECK( *map.Get(c) == "c" );
+		}
+
+		WHEN( "an object in the middle is erased" ) {
+			REQUIRE( map.Erase(b) );
+			THEN( "its handle is no longer valid" ) {
+				CHECK_FALSE( map.Contains(b) );
+				CHECK( map.Get(b) == nullptr );
+				CHECK_FALSE( map.Erase(b) );
+			}
+			THEN( "the other handles still find their objects" ) {
+				CHECK( map.size() == 2 );
+				CHECK( *map.Get(a) == "a" );
+				CHECK( *map.Get(c) == "c" );
+			}
+			THEN( "the storage stays dense" ) {
+				std::vector<std::string> contents(map.begin(), map.end());
+				std::sort(contents.begin(), contents.end());
+				CHECK( contents == std::vector<std::string>{"a", "c"} );
+				for(std::size_t i = 0; i < map.size(); ++i)
+					CHECK( *map.Get(map.HandleAt(i)) == *(map.begin() + i) );
+			}
+
+			AND_WHEN( "a new object is inserted" ) {
+				const SlotHandle d = map.Insert("d");
+				THEN( "it reuses the slot with a new generation" ) {
+					CHECK( d.Index() == b.Index() );
+					CHECK_FALSE( d == b );
+					CHECK_FALSE( map.Contains(b) );
+					CHECK( *map.Get(d) == "d" );
+				}
+			}
+		}
+
+		WHEN( "the map is cleared" ) {
+			map.Clear();
+			THEN( "every handle becomes stale" ) {
+				CHECK( map.empty() );
+				CHECK_FALSE( map.Contains(a) );
+				CHECK_FALSE( map.Contains(b) );
+				CHECK_FALSE( map.Contains(c) );
+			}
+			AND_WHEN( "new objects are inserted" ) {
+				const SlotHandle d = map.Insert("d");
+				THEN( "the old handles do not refer to them" ) {
+					CHECK_FALSE( map.Contains(a) );
+					CHECK( map.Contains(d) );
+					CHECK( map.size() == 1 );
+				}
+			}
+		}
+
+		WHEN( "an object is erased and then the map is cleared" ) {
+			map.Erase(a);
+			map.Clear();
+			THEN( "the slots are reused in ascending order" ) {
+				CHECK( map.Insert("d").Index() == 0 );
+				CHECK( map.Insert("e").Index() == 1 );
+				CHECK( map.Insert("f").Index() == 2 );
+				CHECK( map.Insert("g").Index() == 3 );
+			}
+		}
+	}
+}
+
+SCENARIO( "SlotHandles can be used as hash keys", "[SlotMap]" ) {
+	GIVEN( "handles from repeated insertion and erasure of one slot" ) {
+		SlotMap<int> map;
+		std::unordered_set<SlotHandle, SlotHandle::Hash> seen;
+		for(int i = 0; i < 100; ++i)
+		{
+			SlotHandle handle = map.Insert(i);
+			seen.insert(handle);
+			map.Erase(handle);
+		}
+		THEN( "every handle is unique" ) {
+			CHECK( seen.size() == 100 );
+		}
+	}
+}
+// #endregion unit tests
+
+
+
+} // test namespace
@@ -185,8 +185,8 @@ SCENARIO( "WitnessSystem stepping reports" , "[WitnessSystem][Step]" ) {
 SCENARIO( "WitnessSystem clear" , "[WitnessSystem][Clear]" ) {
 	GIVEN( "a system with pending reports" ) {
 		WitnessSystem system;
-		system.QueueReport(WitnessReport(nullptr, nullptr, 0, 10, nullptr, 5.0));
-		system.QueueReport(WitnessReport(nullptr, nullptr, 0, 20, nullptr, 10.0));
+		system.QueueReport(WitnessReport(nullptr, nullptr, 1, 10, nullptr, 5.0));
+		system.QueueReport(WitnessReport(nullptr, nullptr, 2, 20, nullptr, 10.0));
 		REQUIRE( system.GetPendingReports().size() == 2 );
 
 		WHEN( "system is cleared" ) {
@@ -198,6 +198,67 @@ SCENARIO( "WitnessSystem clear" , "[WitnessSystem][Clear]" ) {
 	}
 }
 
+SCENARIO( "WitnessSystem merging reports" , "[WitnessSystem][Merge]" ) {
+	GIVEN( "a system with a pending report" ) {
+		WitnessSystem system;
+		system.QueueReport(WitnessReport(nullptr, nullptr, 1, 2, nullptr, 5.0));
+
+		WHEN( "a report of the same event is queued" ) {
+			system.QueueReport(WitnessReport(nullptr, nullptr, 1, 10, nullptr, 10.0));
+			THEN( "it is merged into the pending report" ) {
+				REQUIRE( system.GetPendingReports().size() == 1 );
+				const WitnessReport &report = *system.GetPendingReports().begin();
+				CHECK( report.count == 2 );
+				CHECK( report.reputationImpact == Catch::Approx(15.0) );
+			}
+			THEN( "the merged report is due when the first one was" ) {
+				system.StepReports();
+				auto ready = system.StepReports();
+				REQUIRE( ready.size() == 1 );
+				CHECK( ready.front().count == 2 );
+				CHECK( system.GetPendingReports().empty() );
+			}
+		}
+
+		WHEN( "a report of a different event is queued" ) {
+			system.QueueReport(WitnessReport(nullptr, nullptr, 2, 100, nullptr, 10.0));
+			THEN( "both reports are pending" ) {
+				REQUIRE( system.GetPendingReports().size() == 2 );
+			}
+			THEN( "each report is due on its own frame" ) {
+				int firstReady = 0;
+				int secondReady = 0;
+				for(int frame = 1; frame <= 100; ++frame)
+					for(const WitnessReport &report : system.StepReports())
+						(report.eventType == 1 ? firstReady : secondReady) = frame;
+				CHECK( firstReady == 2 );
+				CHECK( secondReady == 100 );
+				CHECK( system.GetPendingReports().empty() );
+			}
+		}
+	}
+}
+
+SCENARIO( "WitnessReport suppression" , "[WitnessSystem][Suppression]" ) {
+	GIVEN( "a suppressible report with two witnesses" ) {
+		WitnessReport report(nullptr, nullptr, 0, 3, nullptr, 10.0);
+		report.canBeSuppressed = true;
+		const SlotHandle first(0, 1);
+		const SlotHandle second(1, 1);
+		report.activeWitnesses.insert(first);
+		report.activeWitnesses.insert(second);
+
+		THEN( "eliminating one witness does not suppress it" ) {
+			CHECK_FALSE( report.EliminateWitness(first) );
+			CHECK_FALSE( report.EliminateWitness(first) );
+		}
+		THEN( "eliminating both witnesses suppresses it" ) {
+			report.EliminateWitness(first);
+			CHECK( report.EliminateWitness(second) );
+		}
+	}
+}
+
 SCENARIO( "Witness constants are reasonable" , "[WitnessSystem][Constants]" ) {
 	THEN( "default witness range should be positive" ) {
 		REQUIRE( WitnessConstants::DEFAULT_WITNESS_RANGE > 0.0 );